@@ -0,0 +1,32 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "memstats.h"
+
+// Arena linear: alocar é avançar um ponteiro, liberar é zerar tudo de uma
+// vez. Usada para memória que vive só durante um frame.
+
+#define ARENA_ALIGN         16
+
+typedef struct {
+    uint8_t *base;
+    size_t size;
+    size_t used;
+    size_t peak;
+    uint32_t allocations;       // Desde o último reset
+    uint32_t failed;
+} Arena;
+
+void arena_init(Arena *arena, void *memory, size_t size);
+
+// Bloco alinhado em ARENA_ALIGN; NULL se não couber
+void *arena_alloc(Arena *arena, size_t size);
+
+// Descarta todas as alocações
+void arena_reset(Arena *arena);
+
+void arena_get_stats(const Arena *arena, MemStats *stats);
+
+#endif // ARENA_H
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "rng.h"
 
 // Tipos básicos para compatibilidade com USPI (DEVE vir ANTES de qualquer include USPI)
 typedef uint8_t u8;
@@ -17,14 +18,21 @@ typedef bool boolean;
 #define CELL_SIZE 16
 #define GAME_WIDTH (SCREEN_WIDTH / CELL_SIZE)
 #define GAME_HEIGHT (SCREEN_HEIGHT / CELL_SIZE)
+#define FRAMEBUFFER_ADDR 0x3C000000   // Usado apenas se o mailbox falhar
+#define GRAPHICS_VSYNC 1              // Aguardar vsync na troca de páginas
 
 // Configurações do jogo
-#define MAX_SNAKE_LENGTH 100
+#define GRID_CELLS (GAME_WIDTH * GAME_HEIGHT)
+#define MAX_SNAKE_LENGTH GRID_CELLS
 #define INITIAL_SNAKE_LENGTH 3
-#define FOOD_SPAWN_RETRIES 10
 #define POINTS_PER_FOOD 10
-#define INPUT_DEBOUNCE_MS 150
+#define TURN_BUFFER_SIZE 3          // Curvas enfileiradas para os próximos passos
 #define GAME_SPEED_MS 200
+#define FRAME_INTERVAL_US 16667     // Cadência de renderização (~60 FPS)
+#define MAX_CATCHUP_STEPS 8         // Passos atrasados simulados de uma vez
+#define MAX_DIRTY_CELLS 64
+#define SMP_RENDER 1                // Renderização no core 1 (smp.h)
+#define DEBUG_SHOW_FPS 1            // Overlay de FPS/tempo de desenho (profile.h)
 
 // Cores (RGB565 format)
 #define COLOR_BLACK     0x0000
@@ -87,19 +95,62 @@ typedef enum {
     GAME_OVER
 } GameState;
 
+// Corpo em buffer circular: body[head] é a cabeça e body[tail] a cauda.
+// Os segmentos seguem de head para tail com índices crescentes (mod MAX).
 typedef struct {
     Position body[MAX_SNAKE_LENGTH];
+    int head;
+    int tail;
     int length;
     Direction direction;
-    Direction next_direction;
+    Direction turns[TURN_BUFFER_SIZE];  // Curvas pendentes, uma por passo
+    int turn_count;
+    uint32_t occupancy[(GRID_CELLS + 31) / 32];   // 1 bit por célula ocupada
 } Snake;
 
+// Consulta O(1) ao mapa de ocupação (posição deve estar dentro do tabuleiro)
+static inline bool snake_occupies(const Snake *snake, Position pos) {
+    int cell = pos.y * GAME_WIDTH + pos.x;
+    return (snake->occupancy[cell >> 5] >> (cell & 31)) & 1;
+}
+
+// Segmento i da cobra (0 = cabeça, length - 1 = cauda)
+static inline Position snake_segment(const Snake *snake, int i) {
+    int index = snake->head + i;
+    if (index >= MAX_SNAKE_LENGTH) {
+        index -= MAX_SNAKE_LENGTH;
+    }
+    return snake->body[index];
+}
+
+// Células alteradas desde o último frame (renderização incremental)
+typedef struct {
+    Position cells[MAX_DIRTY_CELLS];
+    int count;
+    bool full_redraw;   // Estouro da lista ou mudança de estado: redesenhar tudo
+} DirtyCells;
+
+// Gravador de partidas (replay.h)
+typedef struct ReplayRecorder ReplayRecorder;
+
 typedef struct {
     Snake snake;
     Position food;
     int score;
     GameState state;
     uint32_t last_update;
+    Rng rng;                // Gerador aleatório próprio deste jogo
+    DirtyCells dirty;
+    
+    // Células livres: free_cells[0..free_count) é denso e free_index
+    // dá a posição de cada célula livre nesse vetor (remoção por troca)
+    uint16_t free_cells[GRID_CELLS];
+    uint16_t free_index[GRID_CELLS];
+    int free_count;
+    
+    // Gravação de partida: passos simulados desde game_seed e gravador opcional
+    uint32_t steps;
+    ReplayRecorder *recorder;
 } Game;
 
 #endif // CONFIG_H
\ No newline at end of file
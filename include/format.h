@@ -0,0 +1,20 @@
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+// Núcleo de formatação compartilhado por printf, snprintf e LogWrite.
+// Não aloca memória e não usa ponto flutuante.
+//
+// Suporta: %d %i %u %x %X %o %c %s %p %%
+//   flags '-', '0', '+', ' ', '#'; largura e precisão (número ou '*');
+//   modificadores hh, h, l, ll, j, z, t.
+
+// Destino da saída: recebe pedaços já formatados (não terminados em '\0')
+typedef void FormatSink(void *context, const char *data, size_t len);
+
+// Retorna o total de caracteres entregues ao sink
+int vformat(FormatSink *sink, void *context, const char *format, va_list args);
+
+#endif // FORMAT_H
@@ -0,0 +1,19 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include "config.h"
+
+// Núcleo do jogo (independente de plataforma e reentrante: todo o
+// estado, inclusive o gerador aleatório, fica no Game recebido)
+void game_seed(Game *game, uint32_t seed);
+void init_game(Game *game);
+void update_game(Game *game, uint32_t now);    // Avança se GAME_SPEED_MS passou
+void game_step(Game *game);                    // Avança um passo incondicionalmente
+void handle_input(Game *game, unsigned char key);
+void spawn_food(Game *game);
+bool check_collision(const Game *game, Position pos);
+
+// Registrar célula alterada para a renderização incremental
+void mark_cell_dirty(DirtyCells *dirty, Position pos);
+
+#endif // GAME_H
@@ -3,7 +3,20 @@
 
 #include "config.h"
 
-// Variável global do framebuffer
+// Variantes do preenchimento de spans (escolhidas em tempo de compilação)
+#define SPAN_FILL_SCALAR    0   // Um pixel por store
+#define SPAN_FILL_WORD      1   // Stores de 32/64 bits
+#define SPAN_FILL_NEON      2   // Stores NEON de 128 bits
+
+#ifndef GRAPHICS_SPAN_FILL
+#if defined(__ARM_NEON)
+#define GRAPHICS_SPAN_FILL  SPAN_FILL_NEON
+#else
+#define GRAPHICS_SPAN_FILL  SPAN_FILL_WORD
+#endif
+#endif
+
+// Variável global do framebuffer (página de trás)
 extern uint16_t *framebuffer;
 
 // Inicialização gráfica
@@ -15,15 +28,38 @@ void graphics_clear_screen(uint16_t color);
 void graphics_draw_rect(int x, int y, int width, int height, uint16_t color);
 void graphics_draw_rect_outline(int x, int y, int width, int height, uint16_t color);
 
-// Funções de texto
+// Preenche count pixels consecutivos (sem recorte)
+void graphics_fill_span(uint16_t *dst, int count, uint16_t color);
+
+// Região de recorte (clipping) - todas as primitivas respeitam a região ativa
+void graphics_set_clip(int x, int y, int width, int height);
+void graphics_reset_clip(void);
+
+// Funções de texto (glifos pré-rasterizados por cor no atlas)
+#define GLYPH_ATLAS_COLORS 4
 void graphics_draw_char(int x, int y, char c, uint16_t color);
 void graphics_draw_string(int x, int y, const char *str, uint16_t color);
 
+// Cache de texto: permite pular o redesenho de strings inalteradas
+#define TEXT_CACHE_MAX_LEN 32
+typedef struct {
+    int x, y;
+    int width;              // Largura em pixels do texto em cache
+    uint16_t color;
+    bool valid;
+    char text[TEXT_CACHE_MAX_LEN];
+} TextCache;
+
+bool graphics_text_cache_matches(const TextCache *cache, int x, int y, const char *str, uint16_t color);
+void graphics_text_cache_store(TextCache *cache, int x, int y, const char *str, uint16_t color);
+
 // Funções específicas do jogo
 void graphics_draw_game_cell(int grid_x, int grid_y, uint16_t color);
 void graphics_draw_game_cell_bordered(int grid_x, int grid_y, uint16_t fill_color, uint16_t border_color);
 
-// Buffer management (se necessário para double buffering)
+// Double buffering: desenha na página de trás e a exibe no próximo swap
 void graphics_swap_buffers(void);
+int graphics_page_count(void);          // 1 (sem double buffering) ou 2
+void graphics_set_vsync(bool enabled);  // Aguardar vsync a cada swap
 
 #endif // GRAPHICS_H
\ No newline at end of file
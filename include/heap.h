@@ -0,0 +1,51 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "memstats.h"
+
+// Alocador de uso geral sobre uma região fixa de memória.
+//
+// Blocos com cabeçalho de 8 bytes (tamanho do anterior, tamanho + flags) e
+// carga útil alinhada em 16 bytes. Blocos livres ficam em listas por classe
+// de tamanho: exatas até 1 KiB, logarítmicas (4 subdivisões por potência de
+// 2) acima disso, com um bitmap de classes não vazias para a busca.
+//
+// Blocos pequenos liberados vão para listas rápidas (LIFO, sem coalescer) e
+// são reaproveitados em O(1); só são fundidos aos vizinhos quando um pedido
+// não pode ser atendido de outra forma. Os demais são coalescidos na hora.
+//
+// Não é thread-safe: quem chama serializa o acesso (no Pi, mascarando IRQ).
+
+#define HEAP_ALIGN          16
+
+
+// Passa a gerenciar a região [base, base + size)
+void heap_init(void *base, size_t size);
+
+void *heap_alloc(size_t size);
+
+// Carga útil alinhada em 'align' (potência de dois). Buffers que a GPU ou
+// o DMA acessam usam o alinhamento da linha de cache; quem chama também
+// arredonda o tamanho para linhas inteiras.
+void *heap_alloc_aligned(size_t size, size_t align);
+void heap_free(void *ptr);
+void *heap_calloc(size_t count, size_t size);
+
+// Cresce no lugar quando o bloco seguinte está livre; senão, move
+void *heap_realloc(void *ptr, size_t size);
+
+// Como heap_realloc, mas o bloco movido também sai alinhado em 'align'
+void *heap_realloc_aligned(void *ptr, size_t size, size_t align);
+
+// Bytes utilizáveis no bloco (>= tamanho pedido)
+size_t heap_usable_size(const void *ptr);
+
+void heap_get_stats(MemStats *stats);
+
+// Percorre todos os blocos verificando a consistência do heap
+bool heap_check(void);
+
+#endif // HEAP_H
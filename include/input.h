@@ -0,0 +1,46 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "spsc.h"
+
+// Eventos de teclado a partir dos relatórios HID de boot (modificadores e
+// até 6 teclas pressionadas). Cada relatório é comparado com o anterior:
+// teclas que sumiram geram KEY-UP e teclas novas geram KEY-DOWN, na ordem
+// do relatório. O handler da USPi (IRQ) produz e o laço principal consome
+// pela SpscQueue, sem locks nem IRQs mascaradas.
+
+#define INPUT_REPORT_KEYS   6
+#define INPUT_QUEUE_SIZE    32      // Eventos (potência de dois)
+
+// Código que o teclado repete em todas as posições quando há teclas
+// demais pressionadas (phantom state): relatório sem informação
+#define HID_ERROR_ROLLOVER  0x01
+
+typedef struct {
+    uint64_t time_us;       // Chegada do relatório que gerou o evento
+    uint8_t key;            // Código HID
+    uint8_t modifiers;      // Modificadores do mesmo relatório
+    bool pressed;           // true: key-down, false: key-up
+} InputEvent;
+
+typedef struct {
+    SpscQueue queue;
+    uint8_t keys[INPUT_REPORT_KEYS];    // Último relatório (lado do produtor)
+    uint8_t modifiers;
+    volatile uint32_t dropped;          // Eventos perdidos com a fila cheia
+    uint8_t slots[SPSC_REGION_SIZE(sizeof(InputEvent), INPUT_QUEUE_SIZE)]
+        __attribute__((aligned(SPSC_ALIGN)));
+} InputQueue;
+
+void input_init(InputQueue *input);
+
+// Produtor: compara o relatório com o anterior e enfileira as diferenças
+void input_report(InputQueue *input, uint8_t modifiers,
+                  const uint8_t keys[INPUT_REPORT_KEYS], uint64_t time_us);
+
+// Consumidor: próximo evento em ordem de chegada; false com a fila vazia
+bool input_next_event(InputQueue *input, InputEvent *event);
+
+#endif // INPUT_H
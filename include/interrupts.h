@@ -0,0 +1,84 @@
+#ifndef INTERRUPTS_H
+#define INTERRUPTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Controlador de interrupções do BCM2835/2837 (ARM side)
+//   IRQ 0..63  : interrupções da GPU (pending 1 e 2)
+//   IRQ 64..71 : interrupções básicas do ARM (timer ARM, mailbox, ...)
+#define IRQ_LINES           72
+
+#define IRQ_TIMER1          1       // System timer, comparador C1
+#define IRQ_TIMER3          3       // System timer, comparador C3
+#define IRQ_USB             9       // Controlador USB (DWC OTG)
+#define IRQ_UART            57      // PL011
+
+// Assinatura esperada pela USPi (uspios.h)
+typedef void TInterruptHandler(void *pParam);
+
+void ConnectInterrupt(unsigned nIRQ, TInterruptHandler *pHandler, void *pParam);
+void DisconnectInterrupt(unsigned nIRQ);
+
+// Desabilita todas as linhas e limpa a tabela de handlers
+void interrupts_init(void);
+
+// Chamado pelo vetor de IRQ (startup.s, startup64.s): despacha as linhas pendentes
+void irq_dispatch(void);
+
+// Máscara de IRQ: CPSR.I no AArch32, DAIF.I no AArch64. irq_save() e
+// irq_restore() formam uma seção crítica aninhável (salvam o estado anterior).
+// No host não há IRQ: a seção crítica é vazia.
+#if !(defined(__arm__) || defined(__aarch64__)) || defined(__linux__)
+static inline void enable_interrupts(void) {
+}
+
+static inline void disable_interrupts(void) {
+}
+
+static inline uint32_t irq_save(void) {
+    return 0;
+}
+
+static inline void irq_restore(uint32_t flags) {
+    (void)flags;
+}
+#elif defined(__aarch64__)
+static inline void enable_interrupts(void) {
+    __asm__ volatile("msr daifclr, #2" ::: "memory");
+}
+
+static inline void disable_interrupts(void) {
+    __asm__ volatile("msr daifset, #2" ::: "memory");
+}
+
+static inline uint32_t irq_save(void) {
+    uint64_t daif;
+    __asm__ volatile("mrs %0, daif\n\tmsr daifset, #2" : "=r"(daif) :: "memory");
+    return (uint32_t)daif;
+}
+
+static inline void irq_restore(uint32_t daif) {
+    __asm__ volatile("msr daif, %0" :: "r"((uint64_t)daif) : "memory");
+}
+#else
+static inline void enable_interrupts(void) {
+    __asm__ volatile("cpsie i" ::: "memory");
+}
+
+static inline void disable_interrupts(void) {
+    __asm__ volatile("cpsid i" ::: "memory");
+}
+
+static inline uint32_t irq_save(void) {
+    uint32_t cpsr;
+    __asm__ volatile("mrs %0, cpsr\n\tcpsid i" : "=r"(cpsr) :: "memory");
+    return cpsr;
+}
+
+static inline void irq_restore(uint32_t cpsr) {
+    __asm__ volatile("msr cpsr_c, %0" :: "r"(cpsr) : "memory");
+}
+#endif
+
+#endif // INTERRUPTS_H
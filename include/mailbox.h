@@ -0,0 +1,39 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Canal da interface de propriedades (ARM -> VideoCore)
+#define MAILBOX_CHANNEL_PROPERTY    8
+
+// Códigos de requisição/resposta do buffer de propriedades
+#define MAILBOX_REQUEST             0x00000000
+#define MAILBOX_RESPONSE_OK         0x80000000
+
+// Tags usadas pelo framebuffer
+#define TAG_ALLOCATE_BUFFER         0x00040001
+#define TAG_GET_PITCH               0x00040008
+#define TAG_SET_PHYSICAL_SIZE       0x00048003
+#define TAG_SET_VIRTUAL_SIZE        0x00048004
+#define TAG_SET_DEPTH               0x00048005
+#define TAG_SET_VIRTUAL_OFFSET      0x00048009
+#define TAG_WAIT_FOR_VSYNC          0x0004800E
+#define TAG_END                     0x00000000
+
+// O buffer precisa estar alinhado em 16 bytes (os 4 bits baixos levam o
+// canal). Com a cache ligada ele também deve ocupar linhas de cache inteiras
+// (tamanho múltiplo de 64 bytes): a manutenção em mailbox_call() não pode
+// atingir dados vizinhos.
+#define MAILBOX_ALIGN __attribute__((aligned(64)))
+
+// Envia o buffer ao VideoCore e espera a resposta.
+// Retorna true se o firmware processou a requisição com sucesso.
+// No build host esta função é substituída por um simulador.
+bool mailbox_call(uint32_t channel, volatile uint32_t *buffer);
+
+// Converte um endereço de barramento da GPU (ex.: framebuffer alocado)
+// em ponteiro utilizável pelo ARM
+void *mailbox_bus_to_arm(uint32_t bus_address);
+
+#endif // MAILBOX_H
@@ -0,0 +1,20 @@
+#ifndef MEMSTATS_H
+#define MEMSTATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Estatísticas comuns a todos os alocadores (heap, pools, arena de frame)
+typedef struct {
+    size_t size;                // Bytes gerenciados
+    size_t in_use;              // Bytes entregues (no heap, com cabeçalho)
+    size_t peak_in_use;
+    size_t free_bytes;          // Livres (no heap, incluindo as listas rápidas)
+    size_t largest_free;        // Maior pedido atendível de uma vez
+    uint32_t allocations;       // Blocos entregues no momento
+    uint32_t free_blocks;
+    uint32_t failed;            // Pedidos recusados por falta de memória
+    uint32_t fragmentation_pct; // 100 * (1 - largest_free / free_bytes)
+} MemStats;
+
+#endif // MEMSTATS_H
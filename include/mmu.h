@@ -0,0 +1,47 @@
+#ifndef MMU_H
+#define MMU_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// MMU em mapeamento identidade com seções de 1 MiB (tabela de primeiro
+// nível do formato curto do ARMv7) e manutenção da cache de dados.
+//
+//   RAM do ARM                normal write-back/write-allocate, compartilhável
+//   RAM da GPU (framebuffer)  normal sem cache: as escritas se combinam no
+//                             buffer de escrita e a GPU vê tudo sem limpeza
+//   0x3F000000-0x400FFFFF     periféricos e bloco ARM local: device, XN
+//   resto                     sem mapeamento (data abort)
+//
+// Sem a MMU o ARMv7 trata todo acesso a dados como strongly-ordered, mesmo
+// com SCTLR.C ligado. A coerência entre os cores (SMPEN) já vem ligada pelo
+// armstub do firmware.
+
+#define CACHE_LINE_SIZE     64          // L1D e L2 do Cortex-A53
+
+// Monta a tabela (divisão ARM/GPU consultada pelo mailbox) e liga MMU e
+// caches no core atual; chamada uma vez, antes de qualquer outro core
+void mmu_init(void);
+
+// Liga a MMU com a tabela já montada (cores secundários, pelo startup.s)
+void mmu_enable(void);
+
+bool mmu_enabled(void);
+
+// Manutenção por endereço para buffers compartilhados com DMA/VideoCore.
+// Limpar antes de o hardware ler; invalidar antes de ler o que ele
+// escreveu. Invalidar descarta as linhas inteiras: o buffer não pode
+// dividir linha com outros dados.
+void dcache_clean_range(const volatile void *start, size_t size);
+void dcache_invalidate_range(volatile void *start, size_t size);
+void dcache_clean_invalidate_range(const volatile void *start, size_t size);
+
+// Buffers para DMA/VideoCore (syscalls.c, sobre o heap do kernel): carga
+// útil alinhada e tamanho completado até linhas inteiras. O malloc comum
+// não garante isso; dma_realloc mantém o alinhamento mesmo ao mover.
+void *dma_alloc(size_t size);
+void *dma_realloc(void *ptr, size_t size);
+void dma_free(void *ptr);
+
+#endif // MMU_H
@@ -0,0 +1,25 @@
+#ifndef PLATFORM_H
+#define PLATFORM_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Camada de plataforma: tudo que o núcleo do jogo precisa do sistema.
+// Implementada em src/platform_rpi.c (bare metal) e src/host/platform_host.c.
+
+// Relógio monotônico em microssegundos e espera até um prazo
+uint64_t get_time_us(void);
+void sleep_until_us(uint64_t deadline);
+
+// Tempo em milissegundos (derivado de get_time_us) e espera relativa
+uint32_t get_ticks(void);
+void delay_ms(unsigned int ms);
+
+// Fila de eventos de teclado (input.h); antes de registrar o handler
+void platform_input_init(void);
+
+// Entrega as teclas pressionadas desde a chamada anterior ao jogo (via
+// handle_input); chamada uma vez por passo de simulação
+void platform_poll_input(Game *game);
+
+#endif // PLATFORM_H
@@ -0,0 +1,44 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "memstats.h"
+
+// Pool de blocos de tamanho fixo sobre uma região fornecida por quem chama.
+//
+// A lista livre é uma pilha de índices cuja cabeça leva um contador de
+// versão (tag) nos 16 bits altos: alocar e liberar são um único
+// compare-and-swap, sem trava e imune ao problema ABA. Seguro entre o laço
+// principal e handlers de IRQ.
+
+#define POOL_ALIGN          16
+#define POOL_MAX_BLOCKS     0xFFFF
+
+typedef struct {
+    uint8_t *base;
+    uint32_t block_size;        // Arredondado para POOL_ALIGN
+    uint32_t count;
+    volatile uint32_t head;     // tag << 16 | (índice + 1); 0 = vazia
+    volatile uint32_t in_use;
+    volatile uint32_t peak;
+    volatile uint32_t failed;
+} Pool;
+
+// Bytes de região necessários para 'count' blocos de 'block_size'
+#define POOL_REGION_SIZE(block_size, count) \
+    ((((block_size) + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1)) * (count))
+
+// 'memory' deve estar alinhada em POOL_ALIGN e ter POOL_REGION_SIZE bytes
+bool pool_init(Pool *pool, void *memory, size_t block_size, uint32_t count);
+
+void *pool_alloc(Pool *pool);
+void pool_free(Pool *pool, void *ptr);
+
+// O ponteiro pertence a este pool?
+bool pool_owns(const Pool *pool, const void *ptr);
+
+void pool_get_stats(const Pool *pool, MemStats *stats);
+
+#endif // POOL_H
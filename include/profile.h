@@ -0,0 +1,64 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Profiler de zonas nomeadas.
+// No Pi usa a PMU do Cortex-A53 (contador de ciclos, refills de L1D e
+// instruções retiradas); no host, clock_gettime (sem eventos).
+//
+// Cada core grava as próprias amostras. Um core secundário que mede zonas
+// (o render no core 1) chama profile_publish() para entregar uma cópia das
+// estatísticas ao core 0, que é de onde profile_report() as lê.
+
+typedef enum {
+    PROFILE_INPUT,          // Entrega das teclas ao jogo
+    PROFILE_UPDATE,         // Passos de simulação (game_step)
+    PROFILE_DRAW,           // draw_game
+    PROFILE_TIMERS,         // Timers do kernel (tick em IRQ)
+    PROFILE_FRAME,          // Intervalo entre frames (profile_frame_mark)
+    PROFILE_ZONE_COUNT
+} ProfileZone;
+
+// Amostras guardadas por zona (anel); estatísticas sobre as mais recentes
+#define PROFILE_HISTORY     64
+
+typedef struct {
+    const char *name;
+    uint32_t samples;       // Amostras no anel (até PROFILE_HISTORY)
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t max_us;
+    uint32_t avg_cache_misses;  // Refills de L1D por amostra (0 no host)
+    uint32_t avg_instructions;  // Instruções por amostra (0 no host)
+} ProfileStats;
+
+// Limpa as zonas, habilita os contadores e calibra a frequência do
+// contador de ciclos
+void profile_init(void);
+
+// Habilita os contadores do core atual (cada core tem a sua PMU); para
+// cores que medem zonas além do que chamou profile_init
+void profile_init_core(void);
+
+// Delimitam uma zona; zonas diferentes podem se aninhar (e uma IRQ pode
+// medir a sua enquanto o laço principal mede outra)
+void profile_begin(ProfileZone zone);
+void profile_end(ProfileZone zone);
+
+// Registra o intervalo desde a marca anterior em PROFILE_FRAME
+void profile_frame_mark(void);
+
+// Estatísticas do core atual; no core 0, zonas medidas por outro core vêm
+// da última cópia que ele publicou
+void profile_get_stats(ProfileZone zone, ProfileStats *stats);
+
+// Core secundário: publica as estatísticas das suas zonas para o core 0.
+// Não faz nada no core 0 nem no host.
+void profile_publish(void);
+
+// Tabela com todas as zonas via printf
+void profile_report(void);
+
+#endif // PROFILE_H
@@ -0,0 +1,14 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include "config.h"
+#include "memstats.h"
+
+// Desenha o estado atual do jogo (apenas as células alteradas) e
+// consome a lista de células alteradas do jogo
+void draw_game(Game *game);
+
+// Uso da arena de rascunho por frame (pico desde o boot)
+void render_get_frame_stats(MemStats *stats);
+
+#endif // RENDER_H
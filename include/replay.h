@@ -0,0 +1,59 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stddef.h>
+#include "config.h"
+
+// Gravação e reprodução determinística de partidas.
+//
+// Formato (bytes):
+//   "SNKR" | versão (3) | semente (4, little-endian) | eventos...
+// Cada evento é um varint LEB128 de (delta_ticks << 3) | código, onde
+// delta_ticks é o número de passos de simulação desde o evento anterior.
+// Eventos no mesmo passo custam 1 byte; o fluxo termina com REPLAY_END.
+
+#define REPLAY_VERSION      3   // 2: curvas enfileiradas; 3: xoshiro128**
+#define REPLAY_HEADER_SIZE  9
+
+typedef enum {
+    REPLAY_UP = 0,
+    REPLAY_DOWN,
+    REPLAY_LEFT,
+    REPLAY_RIGHT,
+    REPLAY_PAUSE,
+    REPLAY_RESTART,
+    REPLAY_QUIT,
+    REPLAY_END
+} ReplayEvent;
+
+struct ReplayRecorder {
+    uint8_t *buffer;
+    size_t capacity;
+    size_t size;
+    uint32_t last_tick;
+    bool overflow;          // Buffer cheio: gravação truncada
+};
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t pos;
+    uint32_t seed;
+    uint32_t next_tick;     // Passo do próximo evento pendente
+    int next_event;         // -1 quando não há evento pendente
+} ReplayPlayer;
+
+// Gravação: anexe o gravador a Game.recorder e handle_input registra as teclas
+void replay_recorder_init(ReplayRecorder *rec, uint8_t *buffer, size_t capacity, uint32_t seed);
+void replay_record_key(ReplayRecorder *rec, uint32_t tick, unsigned char key);
+void replay_record_end(ReplayRecorder *rec, uint32_t tick);
+
+// Reprodução
+bool replay_player_init(ReplayPlayer *player, const uint8_t *data, size_t size);
+void replay_apply(ReplayPlayer *player, Game *game);    // Eventos do passo atual
+bool replay_finished(const ReplayPlayer *player);
+
+// Re-simula a partida inteira sem renderização; retorna o número de passos
+uint32_t replay_run(ReplayPlayer *player, Game *game);
+
+#endif // REPLAY_H
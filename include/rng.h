@@ -0,0 +1,28 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// Gerador xoshiro128** (Blackman/Vigna): 128 bits de estado, período
+// 2^128 - 1, só somas, rotações e deslocamentos. O estado é explícito (um
+// por jogo), então a mesma semente reproduz a mesma partida.
+
+typedef struct {
+    uint32_t s[4];
+} Rng;
+
+// Expande a semente de 32 bits (a que vai no replay) pelo splitmix32;
+// qualquer semente, inclusive 0, gera um estado válido
+void rng_seed(Rng *rng, uint32_t seed);
+
+uint32_t rng_next(Rng *rng);
+
+// Uniforme em [0, bound) sem viés pela multiplicação de Lemire; a divisão
+// só aparece no caso raro de rejeição. bound > 0.
+uint32_t rng_range(Rng *rng, uint32_t bound);
+
+// Semente imprevisível para uma partida nova: RNG de hardware do BCM2835
+// no Pi (com fallback para o jitter do system timer), relógio no host
+uint32_t rng_entropy_seed(void);
+
+#endif // RNG_H
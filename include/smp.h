@@ -0,0 +1,45 @@
+#ifndef SMP_H
+#define SMP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Partida dos cores secundários do BCM2837 (Cortex-A53 x4).
+// No AArch32 os cores 1-3 esperam no mailbox 3 do bloco ARM local (armstub
+// do firmware ou o laço de espera do startup.s); no AArch64, na spin table
+// do armstub8 (0xD8 + 8 * core). Escrever um endereço ali os libera.
+// IRQs continuam roteadas só para o core 0.
+
+#define SMP_CORES           4
+#define SMP_CORE_STACK_SIZE 0x4000      // Pilha SVC de cada core secundário
+
+// Função executada pelo core liberado
+typedef void SmpEntry(unsigned core, void *param);
+
+// Libera o core e aguarda ele chegar ao C; false se não respondeu
+bool smp_start_core(unsigned core, SmpEntry *entry, void *param);
+
+bool smp_core_running(unsigned core);
+
+// Core atual (MPIDR.Aff0)
+static inline unsigned smp_core_id(void) {
+#if defined(__aarch64__)
+    uint64_t mpidr;
+    __asm__ volatile("mrs %0, mpidr_el1" : "=r"(mpidr));
+#else
+    uint32_t mpidr;
+    __asm__ volatile("mrc p15, 0, %0, c0, c0, 5" : "=r"(mpidr));
+#endif
+    return mpidr & 3;
+}
+
+// Sinalização entre cores: SEV acorda quem está em WFE
+static inline void smp_signal_event(void) {
+    __asm__ volatile("dsb sy\n\tsev" ::: "memory");
+}
+
+static inline void smp_wait_event(void) {
+    __asm__ volatile("wfe" ::: "memory");
+}
+
+#endif // SMP_H
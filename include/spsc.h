@@ -0,0 +1,41 @@
+#ifndef SPSC_H
+#define SPSC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fila sem locks de um produtor e um consumidor com slots de tamanho fixo.
+// O produtor preenche o slot reservado no lugar e o publica; o consumidor
+// lê o slot mais antigo sem cópia e o libera depois. head só é escrito pelo
+// produtor e tail só pelo consumidor, então produtor e consumidor podem
+// estar em cores diferentes.
+
+#define SPSC_ALIGN 16
+
+// Memória necessária para capacity slots de slot_size bytes
+#define SPSC_SLOT_SIZE(slot_size) \
+    (((size_t)(slot_size) + SPSC_ALIGN - 1) & ~(size_t)(SPSC_ALIGN - 1))
+#define SPSC_REGION_SIZE(slot_size, capacity) \
+    (SPSC_SLOT_SIZE(slot_size) * (size_t)(capacity))
+
+typedef struct {
+    uint8_t *slots;
+    uint32_t slot_size;         // Tamanho já arredondado para SPSC_ALIGN
+    uint32_t capacity;          // Potência de dois
+    volatile uint32_t head;     // Slots publicados (contador livre)
+    volatile uint32_t tail;     // Slots liberados (contador livre)
+} SpscQueue;
+
+// memory precisa de SPSC_REGION_SIZE(slot_size, capacity) bytes alinhados
+bool spsc_init(SpscQueue *queue, void *memory, size_t slot_size, uint32_t capacity);
+
+// Produtor: slot livre para preencher (NULL com a fila cheia) e publicação
+void *spsc_reserve(SpscQueue *queue);
+void spsc_publish(SpscQueue *queue);
+
+// Consumidor: slot publicado mais antigo (NULL se vazia) e liberação
+const void *spsc_peek(SpscQueue *queue);
+void spsc_release(SpscQueue *queue);
+
+#endif // SPSC_H
@@ -0,0 +1,35 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// System timer do BCM2835 (contador livre de 1 MHz e comparadores).
+// C0 e C2 pertencem à GPU; o ARM usa C1 (despertar do idle) e C3 (tick).
+
+#define TIMER_TICK_HZ       100     // Tick periódico (timers do kernel da USPi)
+
+// Estatísticas de latência de despertar (comparador C1 -> handler)
+typedef struct {
+    uint32_t wakeups;               // Interrupções de despertar atendidas
+    uint32_t latency_min_us;
+    uint32_t latency_max_us;
+    uint64_t latency_total_us;
+    uint64_t idle_us;               // Tempo total passado em WFI
+    uint32_t ticks;                 // Ticks periódicos desde timer_init
+} TimerStats;
+
+// Contador de 64 bits em microssegundos
+uint64_t get_system_timer(void);
+
+// Conecta C1/C3 ao controlador de interrupções e inicia o tick periódico
+void timer_init(void);
+
+// Dorme em WFI até o prazo (contador >= deadline). Antes de timer_init,
+// ou com prazos muito próximos, apenas aguarda o contador.
+void timer_sleep_until(uint64_t deadline);
+
+void timer_get_stats(TimerStats *stats);
+void timer_reset_stats(void);
+
+#endif // TIMER_H
@@ -0,0 +1,76 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Roda de timers hierárquica (estilo Varghese/Lauck).
+//
+// 4 níveis de 64 posições cobrem 64^4 ticks; prazos além disso ficam numa
+// lista de estouro, redistribuída quando o último nível completa a volta.
+// Inserção e cancelamento são O(1); a expiração é O(1) amortizado (cada
+// timer desce no máximo um nível por cascata). Prazos são de 64 bits.
+//
+// Os timers vivem em blocos alocados sob demanda e reciclados por uma
+// lista livre. O handle combina o índice do timer com uma geração, então
+// cancelar um handle já expirado ou reutilizado não tem efeito.
+//
+// Não é thread-safe: quem chama serializa o acesso (no Pi, mascarando IRQ).
+
+#define TIMER_WHEEL_LEVELS      4
+#define TIMER_WHEEL_SLOT_BITS   6
+#define TIMER_WHEEL_SLOTS       (1 << TIMER_WHEEL_SLOT_BITS)
+
+// Handle: geração nos bits altos, índice + 1 nos baixos (0 = inválido)
+#define TIMER_WHEEL_INDEX_BITS  18
+#define TIMER_WHEEL_MAX_TIMERS  ((1u << TIMER_WHEEL_INDEX_BITS) - 1)
+#define TIMER_WHEEL_CHUNK       64
+#define TIMER_WHEEL_MAX_CHUNKS  ((TIMER_WHEEL_MAX_TIMERS + TIMER_WHEEL_CHUNK - 1) / TIMER_WHEEL_CHUNK)
+
+typedef void TimerWheelHandler(unsigned handle, void *param, void *context);
+
+// Lista circular com sentinela
+typedef struct TimerList {
+    struct TimerList *prev;
+    struct TimerList *next;
+} TimerList;
+
+typedef struct {
+    TimerList link;             // Primeiro membro: TimerList* <-> TimerNode*
+    uint64_t deadline;          // Em ticks
+    TimerWheelHandler *handler;
+    void *param;
+    void *context;
+    uint32_t handle;            // Handle atual (geração + índice)
+    bool active;
+} TimerNode;
+
+typedef struct {
+    uint64_t tick_us;           // Duração de um tick
+    uint64_t now;               // Último tick processado
+    bool started;
+    uint32_t active;            // Timers pendentes
+    
+    TimerList slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    TimerList overflow;
+    
+    TimerNode *free_list;       // Encadeada por link.next
+    uint32_t allocated;         // Timers já criados (em blocos)
+    TimerNode *chunks[TIMER_WHEEL_MAX_CHUNKS];
+} TimerWheel;
+
+void timer_wheel_init(TimerWheel *wheel, uint64_t tick_us);
+
+// Agenda o handler para 'delay_us' após 'now_us'. Retorna 0 se não houver
+// memória para um novo timer.
+unsigned timer_wheel_start(TimerWheel *wheel, uint64_t now_us, uint64_t delay_us,
+                           TimerWheelHandler *handler, void *param, void *context);
+
+// Cancela um timer pendente; handles expirados ou inválidos são ignorados
+bool timer_wheel_cancel(TimerWheel *wheel, unsigned handle);
+
+// Avança a roda até 'now_us' e chama os handlers vencidos. Os handlers
+// podem agendar ou cancelar timers. Retorna quantos expiraram.
+unsigned timer_wheel_advance(TimerWheel *wheel, uint64_t now_us);
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,34 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Passo fixo da simulação desacoplado da renderização.
+//
+// O tempo real é acumulado e consumido em passos de step_us: a velocidade
+// do jogo não depende do custo de desenhar. Os frames seguem uma cadência
+// própria, e o laço principal dorme até o próximo prazo (passo ou frame).
+
+typedef struct {
+    uint64_t step_us;           // Duração de um passo de simulação
+    uint64_t frame_us;          // Intervalo entre frames
+    uint64_t last_time;         // Último instante contabilizado
+    uint64_t accumulator;       // Tempo ainda não simulado
+    uint64_t next_frame;        // Prazo do próximo frame
+    uint32_t max_steps;         // Limite de passos por chamada
+    uint32_t dropped_steps;     // Passos descartados após travamentos longos
+} FrameClock;
+
+void frame_clock_init(FrameClock *clock, uint64_t now, uint64_t step_us, uint64_t frame_us);
+
+// Número de passos de simulação vencidos até 'now'
+uint32_t frame_clock_steps(FrameClock *clock, uint64_t now);
+
+// Indica se um frame deve ser desenhado agora (e agenda o seguinte)
+bool frame_clock_render_due(FrameClock *clock, uint64_t now);
+
+// Próximo instante em que há trabalho: passo ou frame, o que vier antes
+uint64_t frame_clock_next_deadline(const FrameClock *clock);
+
+#endif // TIMING_H
@@ -0,0 +1,46 @@
+#ifndef UART_H
+#define UART_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Console serial no PL011 (UART0) com buffer de transmissão.
+// A escrita só copia para o anel; a FIFO do PL011 é alimentada pela IRQ de
+// TX (depois de uart_enable_irq) ou por uart_poll/uart_flush.
+
+#define UART_TX_BUFFER_SIZE     8192    // Potência de dois
+
+// O que fazer quando o anel enche
+typedef enum {
+    UART_OVERFLOW_DROP,                 // Descarta o excedente (padrão)
+    UART_OVERFLOW_BLOCK                 // Espera a FIFO esvaziar o anel
+} UartOverflowPolicy;
+
+typedef struct {
+    uint32_t bytes_written;             // Aceitos no anel
+    uint32_t bytes_dropped;             // Descartados por falta de espaço
+    uint32_t peak_used;                 // Maior ocupação do anel (bytes)
+} UartStats;
+
+// Configura o PL011 em 115200 8N1 com FIFOs (modo por polling)
+void uart_init(void);
+
+// Conecta a IRQ do PL011: a partir daqui o anel é esvaziado por interrupção
+void uart_enable_irq(void);
+
+void uart_set_overflow_policy(UartOverflowPolicy policy);
+
+// Enfileira bytes para transmissão; retorna quantos foram aceitos
+size_t uart_write(const char *data, size_t len);
+void uart_putc(char c);
+
+// Move o que couber do anel para a FIFO sem esperar (idle)
+void uart_poll(void);
+
+// Espera até o anel e a FIFO esvaziarem
+void uart_flush(void);
+
+void uart_get_stats(UartStats *stats);
+
+#endif // UART_H
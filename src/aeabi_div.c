@@ -0,0 +1,187 @@
+//
+// aeabi_div.c - Rotinas de divisão do AEABI (linkado sem libgcc)
+//
+// Com __ARM_FEATURE_IDIV (Cortex-A53 em AArch32) os operadores de C já
+// viram UDIV/SDIV e estas funções só atendem código pré-compilado (libuspi).
+// Sem divisão em hardware, o divisor é normalizado com CLZ e o laço de
+// subtração roda apenas pelos bits significativos do quociente.
+//
+// Divisão por zero retorna quociente 0 e o dividendo como resto.
+//
+
+#include <stdint.h>
+
+// Quociente nos 32 bits baixos (r0) e resto nos altos (r1)
+static inline uint64_t pack_divmod(uint32_t quotient, uint32_t remainder) {
+    return ((uint64_t)remainder << 32) | quotient;
+}
+
+static inline uint32_t udiv32(uint32_t n, uint32_t d, uint32_t *remainder) {
+#if defined(__ARM_FEATURE_IDIV)
+    uint32_t q = n / d;
+    *remainder = n - q * d;
+    return q;
+#else
+    if (n < d) {
+        *remainder = n;
+        return 0;
+    }
+    
+    int shift = __builtin_clz(d) - __builtin_clz(n);
+    uint32_t q = 0;
+    
+    d <<= shift;
+    for (int i = 0; i <= shift; i++) {
+        q <<= 1;
+        if (n >= d) {
+            n -= d;
+            q |= 1;
+        }
+        d >>= 1;
+    }
+    *remainder = n;
+    return q;
+#endif
+}
+
+static inline int clz64(uint64_t v) {
+    uint32_t hi = (uint32_t)(v >> 32);
+    return hi ? __builtin_clz(hi) : 32 + __builtin_clz((uint32_t)v);
+}
+
+// 64 bits: caminho de 32 bits quando os dois operandos cabem
+static uint64_t udiv64(uint64_t n, uint64_t d, uint64_t *remainder) {
+    if (d == 0) {
+        *remainder = n;
+        return 0;
+    }
+    if ((n >> 32) == 0 && (d >> 32) == 0) {
+        uint32_t r;
+        uint32_t q = udiv32((uint32_t)n, (uint32_t)d, &r);
+        *remainder = r;
+        return q;
+    }
+    if (n < d) {
+        *remainder = n;
+        return 0;
+    }
+    
+    int shift = clz64(d) - clz64(n);
+    uint64_t q = 0;
+    
+    d <<= shift;
+    for (int i = 0; i <= shift; i++) {
+        q <<= 1;
+        if (n >= d) {
+            n -= d;
+            q |= 1;
+        }
+        d >>= 1;
+    }
+    *remainder = n;
+    return q;
+}
+
+// ================================
+// 32 BITS
+// ================================
+
+unsigned int __aeabi_uidiv(unsigned int numerator, unsigned int denominator) {
+    if (denominator == 0) return 0;
+    
+    uint32_t remainder;
+    return udiv32(numerator, denominator, &remainder);
+}
+
+uint64_t __aeabi_uidivmod(unsigned int numerator, unsigned int denominator) {
+    if (denominator == 0) return pack_divmod(0, numerator);
+    
+    uint32_t remainder;
+    uint32_t quotient = udiv32(numerator, denominator, &remainder);
+    return pack_divmod(quotient, remainder);
+}
+
+// Magnitudes em unsigned: INT_MIN não estoura; INT_MIN / -1 dá INT_MIN,
+// como o SDIV
+int __aeabi_idiv(int numerator, int denominator) {
+    if (denominator == 0) return 0;
+    
+    uint32_t n = numerator < 0 ? 0 - (uint32_t)numerator : (uint32_t)numerator;
+    uint32_t d = denominator < 0 ? 0 - (uint32_t)denominator : (uint32_t)denominator;
+    uint32_t remainder;
+    uint32_t q = udiv32(n, d, &remainder);
+    
+    return (int)((numerator < 0) != (denominator < 0) ? 0 - q : q);
+}
+
+// O resto tem o sinal do dividendo
+uint64_t __aeabi_idivmod(int numerator, int denominator) {
+    if (denominator == 0) return pack_divmod(0, (uint32_t)numerator);
+    
+    uint32_t n = numerator < 0 ? 0 - (uint32_t)numerator : (uint32_t)numerator;
+    uint32_t d = denominator < 0 ? 0 - (uint32_t)denominator : (uint32_t)denominator;
+    uint32_t r;
+    uint32_t q = udiv32(n, d, &r);
+    
+    if ((numerator < 0) != (denominator < 0)) {
+        q = 0 - q;
+    }
+    if (numerator < 0) {
+        r = 0 - r;
+    }
+    return pack_divmod(q, r);
+}
+
+// ================================
+// 64 BITS
+// ================================
+
+// Quociente em r0:r1 e resto em r2:r3 não cabem num retorno de C: as
+// entradas do AEABI são cascas em assembly sobre estas funções
+uint64_t aeabi_uldivmod_c(uint64_t numerator, uint64_t denominator, uint64_t *remainder);
+int64_t aeabi_ldivmod_c(int64_t numerator, int64_t denominator, int64_t *remainder);
+
+uint64_t aeabi_uldivmod_c(uint64_t numerator, uint64_t denominator, uint64_t *remainder) {
+    return udiv64(numerator, denominator, remainder);
+}
+
+int64_t aeabi_ldivmod_c(int64_t numerator, int64_t denominator, int64_t *remainder) {
+    uint64_t n = numerator < 0 ? 0 - (uint64_t)numerator : (uint64_t)numerator;
+    uint64_t d = denominator < 0 ? 0 - (uint64_t)denominator : (uint64_t)denominator;
+    uint64_t r;
+    uint64_t q = udiv64(n, d, &r);
+    
+    if (denominator != 0 && (numerator < 0) != (denominator < 0)) {
+        q = 0 - q;
+    }
+    if (numerator < 0) {
+        r = 0 - r;
+    }
+    *remainder = (int64_t)r;
+    return (int64_t)q;
+}
+
+#if defined(__arm__)
+// Entrada: numerador em r0:r1, denominador em r2:r3. O ponteiro do resto
+// vai na pilha (quinto argumento); a pilha continua alinhada em 8.
+#define AEABI_DIVMOD64(name, impl)          \
+    __asm__(                                \
+        "    .text\n"                       \
+        "    .arm\n"                        \
+        "    .align 2\n"                    \
+        "    .global " #name "\n"           \
+        "    .type " #name ", %function\n"  \
+        #name ":\n"                         \
+        "    push    {r11, lr}\n"           \
+        "    sub     sp, sp, #16\n"         \
+        "    add     r12, sp, #8\n"         \
+        "    str     r12, [sp]\n"           \
+        "    bl      " #impl "\n"           \
+        "    ldrd    r2, r3, [sp, #8]\n"    \
+        "    add     sp, sp, #16\n"         \
+        "    pop     {r11, pc}\n"           \
+        "    .size " #name ", . - " #name "\n")
+
+AEABI_DIVMOD64(__aeabi_uldivmod, aeabi_uldivmod_c);
+AEABI_DIVMOD64(__aeabi_ldivmod, aeabi_ldivmod_c);
+#endif
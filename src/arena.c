@@ -0,0 +1,52 @@
+//
+// arena.c - Arena linear com reset em uma operação
+//
+
+#include "arena.h"
+
+void arena_init(Arena *arena, void *memory, size_t size) {
+    // Início alinhado: as alocações só arredondam o tamanho
+    uintptr_t start = ((uintptr_t)memory + ARENA_ALIGN - 1) & ~(uintptr_t)(ARENA_ALIGN - 1);
+    size_t skew = start - (uintptr_t)memory;
+    
+    arena->base = (uint8_t *)start;
+    arena->size = size > skew ? size - skew : 0;
+    arena->used = 0;
+    arena->peak = 0;
+    arena->allocations = 0;
+    arena->failed = 0;
+}
+
+void *arena_alloc(Arena *arena, size_t size) {
+    size_t rounded = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    
+    if (rounded < size || rounded > arena->size - arena->used) {
+        arena->failed++;
+        return NULL;
+    }
+    
+    void *ptr = arena->base + arena->used;
+    arena->used += rounded;
+    arena->allocations++;
+    if (arena->used > arena->peak) {
+        arena->peak = arena->used;
+    }
+    return ptr;
+}
+
+void arena_reset(Arena *arena) {
+    arena->used = 0;
+    arena->allocations = 0;
+}
+
+void arena_get_stats(const Arena *arena, MemStats *stats) {
+    stats->size = arena->size;
+    stats->in_use = arena->used;
+    stats->peak_in_use = arena->peak;
+    stats->free_bytes = arena->size - arena->used;
+    stats->largest_free = stats->free_bytes;
+    stats->allocations = arena->allocations;
+    stats->free_blocks = stats->free_bytes ? 1 : 0;
+    stats->failed = arena->failed;
+    stats->fragmentation_pct = 0;
+}
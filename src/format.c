@@ -0,0 +1,406 @@
+//
+// format.c - Núcleo de formatação (printf/snprintf/LogWrite) sem alocação
+//
+// Inteiros de até 32 bits são convertidos dois dígitos por vez com uma
+// tabela de pares; divisões por constantes viram multiplicações, sem
+// chamar __aeabi_uidiv. Valores de 64 bits são reduzidos em blocos de
+// 10^4 com divisões de 32 bits, sem __aeabi_uldivmod.
+//
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "format.h"
+
+#define FLAG_LEFT       (1 << 0)    // '-'
+#define FLAG_ZERO       (1 << 1)    // '0'
+#define FLAG_PLUS       (1 << 2)    // '+'
+#define FLAG_SPACE      (1 << 3)    // ' '
+#define FLAG_ALT        (1 << 4)    // '#'
+
+// Maior conversão: 64 bits em octal (22 dígitos)
+#define NUMBER_BUFFER   24
+
+typedef struct {
+    FormatSink *sink;
+    void *context;
+    int count;
+} FormatState;
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char hex_lower[] = "0123456789abcdef";
+static const char hex_upper[] = "0123456789ABCDEF";
+
+static void emit(FormatState *st, const char *data, size_t len) {
+    if (len) {
+        st->sink(st->context, data, len);
+        st->count += (int)len;
+    }
+}
+
+// Preenchimento em blocos, sem laço de caractere a caractere no sink
+static void emit_fill(FormatState *st, char c, int n) {
+    static const char spaces[16] = "                ";
+    static const char zeros[16] = "0000000000000000";
+    const char *fill = c == '0' ? zeros : spaces;
+    
+    while (n > 0) {
+        int chunk = n < 16 ? n : 16;
+        emit(st, fill, (size_t)chunk);
+        n -= chunk;
+    }
+}
+
+// Decimal de 32 bits escrito de trás para frente a partir de end
+static char *u32_to_dec(char *end, uint32_t v) {
+    while (v >= 100) {
+        const char *pair = &digit_pairs[(v % 100) * 2];
+        v /= 100;
+        *--end = pair[1];
+        *--end = pair[0];
+    }
+    if (v >= 10) {
+        *--end = digit_pairs[v * 2 + 1];
+        *--end = digit_pairs[v * 2];
+    } else {
+        *--end = (char)('0' + v);
+    }
+    return end;
+}
+
+// Divide v por 10^4 em limbs de 16 bits: cada passo divide um valor
+// menor que 10^4 * 2^16 (< 2^32) por uma constante
+static uint64_t u64_div_10000(uint64_t v, uint32_t *rem) {
+    uint32_t limbs[4] = {
+        (uint32_t)(v >> 48) & 0xFFFF, (uint32_t)(v >> 32) & 0xFFFF,
+        (uint32_t)(v >> 16) & 0xFFFF, (uint32_t)v & 0xFFFF
+    };
+    uint64_t q = 0;
+    uint32_t r = 0;
+    
+    for (int i = 0; i < 4; i++) {
+        uint32_t cur = (r << 16) | limbs[i];
+        q = (q << 16) | (cur / 10000);
+        r = cur % 10000;
+    }
+    *rem = r;
+    return q;
+}
+
+static char *u64_to_dec(char *end, uint64_t v) {
+    while (v > UINT32_MAX) {
+        uint32_t rem;
+        v = u64_div_10000(v, &rem);
+        
+        // Bloco interno: sempre 4 dígitos
+        const char *lo = &digit_pairs[(rem % 100) * 2];
+        const char *hi = &digit_pairs[(rem / 100) * 2];
+        *--end = lo[1];
+        *--end = lo[0];
+        *--end = hi[1];
+        *--end = hi[0];
+    }
+    return u32_to_dec(end, (uint32_t)v);
+}
+
+// Bases potência de dois: só deslocamentos
+static char *u64_to_base(char *end, uint64_t v, unsigned shift, const char *digits) {
+    unsigned mask = (1u << shift) - 1;
+    
+    do {
+        *--end = digits[v & mask];
+        v >>= shift;
+    } while (v);
+    return end;
+}
+
+// Monta sinal/prefixo, zeros de precisão e preenchimento de largura
+static void emit_number(FormatState *st, const char *digits, int len,
+                        const char *prefix, int prefix_len,
+                        int flags, int width, int precision) {
+    int zeros = precision > len ? precision - len : 0;
+    int total = prefix_len + zeros + len;
+    int pad = width > total ? width - total : 0;
+    
+    // '0' só vale sem precisão e sem '-'
+    if ((flags & FLAG_ZERO) && !(flags & FLAG_LEFT) && precision < 0) {
+        zeros += pad;
+        pad = 0;
+    }
+    
+    if (!(flags & FLAG_LEFT)) {
+        emit_fill(st, ' ', pad);
+    }
+    emit(st, prefix, (size_t)prefix_len);
+    emit_fill(st, '0', zeros);
+    emit(st, digits, (size_t)len);
+    if (flags & FLAG_LEFT) {
+        emit_fill(st, ' ', pad);
+    }
+}
+
+static void emit_string(FormatState *st, const char *s, int flags, int width, int precision) {
+    int len = 0;
+    
+    if (!s) {
+        s = "(null)";
+    }
+    while ((precision < 0 || len < precision) && s[len]) {
+        len++;
+    }
+    
+    int pad = width > len ? width - len : 0;
+    if (!(flags & FLAG_LEFT)) {
+        emit_fill(st, ' ', pad);
+    }
+    emit(st, s, (size_t)len);
+    if (flags & FLAG_LEFT) {
+        emit_fill(st, ' ', pad);
+    }
+}
+
+// Lê o argumento inteiro conforme o modificador de tamanho
+enum { LEN_NONE, LEN_HH, LEN_H, LEN_L, LEN_LL, LEN_J, LEN_Z, LEN_T };
+
+static int64_t arg_signed(va_list *args, int length) {
+    switch (length) {
+        case LEN_HH: return (signed char)va_arg(*args, int);
+        case LEN_H:  return (short)va_arg(*args, int);
+        case LEN_L:  return va_arg(*args, long);
+        case LEN_LL: return va_arg(*args, long long);
+        case LEN_J:  return va_arg(*args, intmax_t);
+        case LEN_Z:  return (int64_t)va_arg(*args, size_t);
+        case LEN_T:  return va_arg(*args, ptrdiff_t);
+        default:     return va_arg(*args, int);
+    }
+}
+
+static uint64_t arg_unsigned(va_list *args, int length) {
+    switch (length) {
+        case LEN_HH: return (unsigned char)va_arg(*args, unsigned int);
+        case LEN_H:  return (unsigned short)va_arg(*args, unsigned int);
+        case LEN_L:  return va_arg(*args, unsigned long);
+        case LEN_LL: return va_arg(*args, unsigned long long);
+        case LEN_J:  return va_arg(*args, uintmax_t);
+        case LEN_Z:  return va_arg(*args, size_t);
+        case LEN_T:  return (uint64_t)va_arg(*args, ptrdiff_t);
+        default:     return va_arg(*args, unsigned int);
+    }
+}
+
+int vformat(FormatSink *sink, void *context, const char *format, va_list args) {
+    FormatState st = { sink, context, 0 };
+    va_list ap;
+    const char *p = format;
+    
+    // Cópia local: os leitores de argumento recebem um ponteiro para ela
+    va_copy(ap, args);
+    
+    while (*p) {
+        // Texto literal até o próximo '%' de uma vez só
+        const char *run = p;
+        while (*p && *p != '%') {
+            p++;
+        }
+        emit(&st, run, (size_t)(p - run));
+        if (!*p) {
+            break;
+        }
+        
+        const char *spec_start = p++;
+        int flags = 0;
+        int width = 0;
+        int precision = -1;
+        int length = LEN_NONE;
+        
+        // Flags
+        for (;; p++) {
+            if (*p == '-') flags |= FLAG_LEFT;
+            else if (*p == '0') flags |= FLAG_ZERO;
+            else if (*p == '+') flags |= FLAG_PLUS;
+            else if (*p == ' ') flags |= FLAG_SPACE;
+            else if (*p == '#') flags |= FLAG_ALT;
+            else break;
+        }
+        
+        // Largura
+        if (*p == '*') {
+            width = va_arg(ap, int);
+            if (width < 0) {
+                flags |= FLAG_LEFT;
+                width = -width;
+            }
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                width = width * 10 + (*p++ - '0');
+            }
+        }
+        
+        // Precisão (negativa via '*' equivale a ausente)
+        if (*p == '.') {
+            p++;
+            precision = 0;
+            if (*p == '*') {
+                precision = va_arg(ap, int);
+                if (precision < 0) {
+                    precision = -1;
+                }
+                p++;
+            } else {
+                while (*p >= '0' && *p <= '9') {
+                    precision = precision * 10 + (*p++ - '0');
+                }
+            }
+        }
+        
+        // Tamanho
+        switch (*p) {
+            case 'h':
+                p++;
+                length = LEN_H;
+                if (*p == 'h') {
+                    p++;
+                    length = LEN_HH;
+                }
+                break;
+            case 'l':
+                p++;
+                length = LEN_L;
+                if (*p == 'l') {
+                    p++;
+                    length = LEN_LL;
+                }
+                break;
+            case 'j': p++; length = LEN_J; break;
+            case 'z': p++; length = LEN_Z; break;
+            case 't': p++; length = LEN_T; break;
+            default: break;
+        }
+        
+        char buffer[NUMBER_BUFFER];
+        char *end = buffer + sizeof(buffer);
+        char *digits;
+        char prefix[2];
+        int prefix_len = 0;
+        
+        switch (*p) {
+            case 'd':
+            case 'i': {
+                int64_t val = arg_signed(&ap, length);
+                
+                // Magnitude em unsigned: sem estouro em INT_MIN/INT64_MIN
+                uint64_t mag = val < 0 ? 0 - (uint64_t)val : (uint64_t)val;
+                digits = mag > UINT32_MAX ? u64_to_dec(end, mag) : u32_to_dec(end, (uint32_t)mag);
+                if (val < 0) {
+                    prefix[prefix_len++] = '-';
+                } else if (flags & FLAG_PLUS) {
+                    prefix[prefix_len++] = '+';
+                } else if (flags & FLAG_SPACE) {
+                    prefix[prefix_len++] = ' ';
+                }
+                if (precision == 0 && mag == 0) {
+                    digits = end;
+                }
+                emit_number(&st, digits, (int)(end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            }
+            case 'u': {
+                uint64_t val = arg_unsigned(&ap, length);
+                digits = val > UINT32_MAX ? u64_to_dec(end, val) : u32_to_dec(end, (uint32_t)val);
+                if (precision == 0 && val == 0) {
+                    digits = end;
+                }
+                emit_number(&st, digits, (int)(end - digits), prefix, 0,
+                            flags, width, precision);
+                break;
+            }
+            case 'x':
+            case 'X': {
+                uint64_t val = arg_unsigned(&ap, length);
+                digits = u64_to_base(end, val, 4, *p == 'x' ? hex_lower : hex_upper);
+                if (precision == 0 && val == 0) {
+                    digits = end;
+                }
+                if ((flags & FLAG_ALT) && val != 0) {
+                    prefix[prefix_len++] = '0';
+                    prefix[prefix_len++] = *p;
+                }
+                emit_number(&st, digits, (int)(end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            }
+            case 'o': {
+                uint64_t val = arg_unsigned(&ap, length);
+                digits = u64_to_base(end, val, 3, hex_lower);
+                if (precision == 0 && val == 0) {
+                    digits = end;
+                }
+                int len = (int)(end - digits);
+                
+                // '#' garante um zero à esquerda
+                if ((flags & FLAG_ALT) && (len == 0 || *digits != '0') && precision <= len) {
+                    *--digits = '0';
+                    len++;
+                }
+                emit_number(&st, digits, len, prefix, 0, flags, width, precision);
+                break;
+            }
+            case 'p': {
+                void *ptr = va_arg(ap, void *);
+                if (!ptr) {
+                    emit_string(&st, "(nil)", flags, width, -1);
+                    break;
+                }
+                digits = u64_to_base(end, (uintptr_t)ptr, 4, hex_lower);
+                prefix[prefix_len++] = '0';
+                prefix[prefix_len++] = 'x';
+                emit_number(&st, digits, (int)(end - digits), prefix, prefix_len,
+                            flags, width, precision);
+                break;
+            }
+            case 'c': {
+                char c = (char)va_arg(ap, int);
+                int pad = width > 1 ? width - 1 : 0;
+                if (!(flags & FLAG_LEFT)) {
+                    emit_fill(&st, ' ', pad);
+                }
+                emit(&st, &c, 1);
+                if (flags & FLAG_LEFT) {
+                    emit_fill(&st, ' ', pad);
+                }
+                break;
+            }
+            case 's':
+                emit_string(&st, va_arg(ap, const char *), flags, width, precision);
+                break;
+            case '%':
+                emit(&st, "%", 1);
+                break;
+            default:
+                // Especificação desconhecida (ou '%' no fim): copiar como está
+                if (!*p) {
+                    emit(&st, spec_start, (size_t)(p - spec_start));
+                    continue;
+                }
+                emit(&st, spec_start, (size_t)(p + 1 - spec_start));
+                break;
+        }
+        p++;
+    }
+    
+    va_end(ap);
+    return st.count;
+}
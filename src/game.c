@@ -0,0 +1,283 @@
+//
+// game.c - Núcleo do jogo Snake (lógica independente de plataforma)
+//
+
+#include "game.h"
+#include "replay.h"
+
+static void mark_full_redraw(Game *game);
+
+void game_seed(Game *game, uint32_t seed) {
+    rng_seed(&game->rng, seed);
+    game->steps = 0;
+    game->recorder = NULL;
+}
+
+// Registrar célula alterada para a renderização incremental
+void mark_cell_dirty(DirtyCells *dirty, Position pos) {
+    if (dirty->full_redraw) {
+        return;
+    }
+    
+    for (int i = 0; i < dirty->count; i++) {
+        if (dirty->cells[i].x == pos.x && dirty->cells[i].y == pos.y) {
+            return;
+        }
+    }
+    
+    if (dirty->count >= MAX_DIRTY_CELLS) {
+        // Lista cheia: mais barato redesenhar tudo uma vez
+        dirty->full_redraw = true;
+        return;
+    }
+    dirty->cells[dirty->count++] = pos;
+}
+
+// Forçar redesenho completo (reinício, pausa, game over)
+static void mark_full_redraw(Game *game) {
+    game->dirty.full_redraw = true;
+    game->dirty.count = 0;
+}
+
+// Atualização incremental do mapa de ocupação e do conjunto de células livres
+static void occupy_cell(Game *game, Position pos) {
+    int cell = pos.y * GAME_WIDTH + pos.x;
+    game->snake.occupancy[cell >> 5] |= 1u << (cell & 31);
+    
+    // Remover do conjunto livre trocando com o último elemento
+    int index = game->free_index[cell];
+    int last = game->free_cells[--game->free_count];
+    game->free_cells[index] = last;
+    game->free_index[last] = index;
+}
+
+static void release_cell(Game *game, Position pos) {
+    int cell = pos.y * GAME_WIDTH + pos.x;
+    game->snake.occupancy[cell >> 5] &= ~(1u << (cell & 31));
+    
+    game->free_index[cell] = game->free_count;
+    game->free_cells[game->free_count++] = cell;
+}
+
+// Verificar colisão
+bool check_collision(const Game *game, Position pos) {
+    // Verificar colisão com bordas
+    if (pos.x < 0 || pos.x >= GAME_WIDTH || pos.y < 0 || pos.y >= GAME_HEIGHT) {
+        return true;
+    }
+    
+    // Verificar colisão com o corpo da cobra (a cabeça não conta)
+    if (!snake_occupies(&game->snake, pos)) {
+        return false;
+    }
+    Position head = game->snake.body[game->snake.head];
+    return pos.x != head.x || pos.y != head.y;
+}
+
+// Inicializar jogo
+void init_game(Game *game) {
+    game->snake.length = INITIAL_SNAKE_LENGTH;
+    game->snake.head = 0;
+    game->snake.tail = INITIAL_SNAKE_LENGTH - 1;
+    game->snake.direction = DIR_RIGHT;
+    game->snake.turn_count = 0;
+    game->score = 0;
+    game->state = GAME_RUNNING;
+    game->last_update = 0;
+    mark_full_redraw(game);
+    
+    // Posicionar cobra no centro
+    int start_x = GAME_WIDTH / 2;
+    int start_y = GAME_HEIGHT / 2;
+    
+    for (int i = 0; i < (int)(sizeof(game->snake.occupancy) / sizeof(game->snake.occupancy[0])); i++) {
+        game->snake.occupancy[i] = 0;
+    }
+    for (int cell = 0; cell < GRID_CELLS; cell++) {
+        game->free_cells[cell] = cell;
+        game->free_index[cell] = cell;
+    }
+    game->free_count = GRID_CELLS;
+    for (int i = 0; i < game->snake.length; i++) {
+        game->snake.body[i].x = start_x - i;
+        game->snake.body[i].y = start_y;
+        occupy_cell(game, game->snake.body[i]);
+    }
+    
+    spawn_food(game);
+}
+
+// Gerar nova comida
+void spawn_food(Game *game) {
+    mark_cell_dirty(&game->dirty, game->food);
+    
+    // Tabuleiro cheio: a cobra ocupou todas as células
+    if (game->free_count == 0) {
+        game->food.x = -1;
+        game->food.y = -1;
+        game->state = GAME_OVER;
+        mark_full_redraw(game);
+        return;
+    }
+    
+    // Sorteio único entre as células livres: tempo constante e sempre válido
+    int cell = game->free_cells[rng_range(&game->rng, game->free_count)];
+    game->food.x = cell % GAME_WIDTH;
+    game->food.y = cell / GAME_WIDTH;
+    
+    mark_cell_dirty(&game->dirty, game->food);
+}
+
+static bool opposite_directions(Direction a, Direction b) {
+    return (a == DIR_UP && b == DIR_DOWN) || (a == DIR_DOWN && b == DIR_UP) ||
+           (a == DIR_LEFT && b == DIR_RIGHT) || (a == DIR_RIGHT && b == DIR_LEFT);
+}
+
+// Enfileira uma curva para os próximos passos. Ela é validada contra a
+// direção que a cobra terá quando for aplicada (a última pendente), então
+// "cima e esquerda" no mesmo passo viram duas curvas seguidas em vez de a
+// segunda ser descartada ou sobrescrever a primeira.
+static void queue_turn(Snake *snake, Direction dir) {
+    Direction last = snake->turn_count > 0 ? snake->turns[snake->turn_count - 1]
+                                           : snake->direction;
+    
+    if (dir == last || opposite_directions(dir, last) ||
+        snake->turn_count == TURN_BUFFER_SIZE) {
+        return;
+    }
+    snake->turns[snake->turn_count++] = dir;
+}
+
+// Tratamento de entrada
+void handle_input(Game *game, unsigned char key) {
+    if (game->recorder) {
+        replay_record_key(game->recorder, game->steps, key);
+    }
+    
+    if (game->state == GAME_OVER) {
+        switch (key) {
+            case KEY_RESTART_1:
+            case KEY_RESTART_2:
+                init_game(game);
+                return;
+            case KEY_QUIT_1:
+            case KEY_QUIT_2:
+                game->state = GAME_OVER; // Manter no game over ou implementar saída
+                return;
+        }
+        return;
+    }
+    
+    switch (key) {
+        case KEY_UP_1:
+        case KEY_UP_2:
+            queue_turn(&game->snake, DIR_UP);
+            break;
+        case KEY_DOWN_1:
+        case KEY_DOWN_2:
+            queue_turn(&game->snake, DIR_DOWN);
+            break;
+        case KEY_LEFT_1:
+        case KEY_LEFT_2:
+            queue_turn(&game->snake, DIR_LEFT);
+            break;
+        case KEY_RIGHT_1:
+        case KEY_RIGHT_2:
+            queue_turn(&game->snake, DIR_RIGHT);
+            break;
+        case KEY_RESTART_1:
+        case KEY_RESTART_2:
+            init_game(game);
+            break;
+        case KEY_QUIT_1:
+        case KEY_QUIT_2:
+            game->state = GAME_OVER;
+            mark_full_redraw(game);
+            break;
+        case KEY_PAUSE_1:
+        case KEY_PAUSE_2:
+            if (game->state == GAME_RUNNING) {
+                game->state = GAME_PAUSED;
+            } else if (game->state == GAME_PAUSED) {
+                game->state = GAME_RUNNING;
+            }
+            mark_full_redraw(game);
+            break;
+    }
+}
+
+// Atualizar jogo
+void update_game(Game *game, uint32_t now) {
+    if (game->state != GAME_RUNNING) {
+        return;
+    }
+    
+    if (now - game->last_update < GAME_SPEED_MS) {
+        return;
+    }
+    
+    game->last_update = now;
+    game_step(game);
+}
+
+// Avançar exatamente um passo de simulação (sem controle de tempo)
+void game_step(Game *game) {
+    if (game->state != GAME_RUNNING) {
+        return;
+    }
+    game->steps++;
+    
+    // Aplicar a curva mais antiga pendente
+    if (game->snake.turn_count > 0) {
+        game->snake.direction = game->snake.turns[0];
+        game->snake.turn_count--;
+        for (int i = 0; i < game->snake.turn_count; i++) {
+            game->snake.turns[i] = game->snake.turns[i + 1];
+        }
+    }
+    
+    // Calcular nova posição da cabeça
+    Position old_head = game->snake.body[game->snake.head];
+    Position new_head = old_head;
+    
+    switch (game->snake.direction) {
+        case DIR_UP:    new_head.y--; break;
+        case DIR_DOWN:  new_head.y++; break;
+        case DIR_LEFT:  new_head.x--; break;
+        case DIR_RIGHT: new_head.x++; break;
+    }
+    
+    // Verificar colisão
+    if (check_collision(game, new_head)) {
+        game->state = GAME_OVER;
+        mark_full_redraw(game);
+        return;
+    }
+    
+    bool ate_food = new_head.x == game->food.x && new_head.y == game->food.y;
+    bool grows = ate_food && game->snake.length < MAX_SNAKE_LENGTH;
+    
+    // Cabeça antiga vira corpo; a cauda só sai do lugar se a cobra não cresceu
+    mark_cell_dirty(&game->dirty, old_head);
+    mark_cell_dirty(&game->dirty, new_head);
+    if (!grows) {
+        mark_cell_dirty(&game->dirty, game->snake.body[game->snake.tail]);
+        release_cell(game, game->snake.body[game->snake.tail]);
+    }
+    occupy_cell(game, new_head);
+    
+    // Mover cobra em O(1): nova cabeça antes da atual, cauda recua um índice
+    game->snake.head = game->snake.head == 0 ? MAX_SNAKE_LENGTH - 1 : game->snake.head - 1;
+    game->snake.body[game->snake.head] = new_head;
+    if (grows) {
+        game->snake.length++;
+    } else {
+        game->snake.tail = game->snake.tail == 0 ? MAX_SNAKE_LENGTH - 1 : game->snake.tail - 1;
+    }
+    
+    // Verificar se comeu comida
+    if (ate_food) {
+        game->score += POINTS_PER_FOOD;
+        spawn_food(game);
+    }
+}
@@ -84,7 +84,7 @@
 // CONFIGURAÇÕES DE DEBUG
 // ========================
 #define DEBUG_ENABLED       1           // 0 = desabilitado, 1 = habilitado
-#define DEBUG_SHOW_FPS      1           // Mostrar FPS (requer implementação)
+#define DEBUG_SHOW_FPS      1           // Mostrar FPS (overlay em render.c)
 #define DEBUG_SHOW_COORDS   0           // Mostrar coordenadas da cobra
 #define DEBUG_UART_OUTPUT   1           // Debug via UART
 
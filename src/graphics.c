@@ -1,9 +1,34 @@
 #include "graphics.h"
+#include "mailbox.h"
 #include <string.h>
 
-// Framebuffer global
+#if GRAPHICS_SPAN_FILL == SPAN_FILL_NEON
+#include <arm_neon.h>
+#endif
+
+// Acessos largos ao framebuffer sem violar strict aliasing
+typedef uint32_t __attribute__((may_alias)) fb_word_t;
+typedef uint64_t __attribute__((may_alias)) fb_dword_t;
+
+// Framebuffer global (sempre aponta para a página de trás)
 uint16_t *framebuffer = NULL;
 
+// Memória alocada pela GPU: duas páginas empilhadas verticalmente
+static uint16_t *fb_base = NULL;
+static int fb_stride = SCREEN_WIDTH;    // Pixels por linha (pitch / 2)
+static int fb_pages = 1;
+static int fb_back_page = 0;
+static bool fb_vsync = GRAPHICS_VSYNC;
+
+// Buffer de propriedades do mailbox
+static volatile uint32_t MAILBOX_ALIGN mbox[32];
+
+// Região de recorte ativa (limites exclusivos em x1/y1)
+static int clip_x0 = 0;
+static int clip_y0 = 0;
+static int clip_x1 = SCREEN_WIDTH;
+static int clip_y1 = SCREEN_HEIGHT;
+
 // Font simples 8x8 (bitmap básico para ASCII)
 static const uint8_t font_8x8[96][8] = {
     // Espaço (32)
@@ -126,71 +151,375 @@ static const uint8_t font_8x8[96][8] = {
     // Restante dos caracteres pode ser preenchido conforme necessário
 };
 
+// Atlas de glifos: cada linha do font_8x8 expandida uma única vez em
+// pixels RGB565 prontos para cópia, mais os trechos (runs) de bits acesos
+#define GLYPH_COUNT 96
+
+typedef struct {
+    uint8_t count;
+    uint8_t start[4];
+    uint8_t len[4];
+} GlyphRowRuns;
+
+static GlyphRowRuns glyph_runs[GLYPH_COUNT][8];
+static uint16_t glyph_pixels[GLYPH_ATLAS_COLORS][GLYPH_COUNT][8][8];
+static uint16_t glyph_colors[GLYPH_ATLAS_COLORS];
+static int glyph_color_count = 0;
+static int glyph_next_evict = 0;
+
+static void build_glyph_runs(void) {
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        for (int row = 0; row < 8; row++) {
+            GlyphRowRuns *runs = &glyph_runs[g][row];
+            uint8_t line = font_8x8[g][row];
+            runs->count = 0;
+            
+            int col = 0;
+            while (col < 8) {
+                if (!(line & (0x80 >> col))) {
+                    col++;
+                    continue;
+                }
+                int start = col;
+                while (col < 8 && (line & (0x80 >> col))) {
+                    col++;
+                }
+                // No máximo 4 trechos em 8 bits
+                runs->start[runs->count] = start;
+                runs->len[runs->count] = col - start;
+                runs->count++;
+            }
+        }
+    }
+}
+
+// Retorna o slot do atlas para a cor, expandindo-o se ainda não existir
+static int glyph_atlas_slot(uint16_t color) {
+    for (int i = 0; i < glyph_color_count; i++) {
+        if (glyph_colors[i] == color) {
+            return i;
+        }
+    }
+    
+    int slot;
+    if (glyph_color_count < GLYPH_ATLAS_COLORS) {
+        slot = glyph_color_count++;
+    } else {
+        slot = glyph_next_evict;
+        glyph_next_evict = (glyph_next_evict + 1) % GLYPH_ATLAS_COLORS;
+    }
+    
+    glyph_colors[slot] = color;
+    for (int g = 0; g < GLYPH_COUNT; g++) {
+        for (int row = 0; row < 8; row++) {
+            uint8_t line = font_8x8[g][row];
+            for (int col = 0; col < 8; col++) {
+                glyph_pixels[slot][g][row][col] = (line & (0x80 >> col)) ? color : 0;
+            }
+        }
+    }
+    return slot;
+}
+
+// Copia os trechos acesos de um glifo, recortando contra a região ativa.
+// Cada trecho é um memcpy da linha do atlas; uma linha toda acesa é uma
+// única cópia de 16 bytes.
+static void blit_glyph(int x, int y, int glyph, int slot) {
+    if (x >= clip_x1 || x + 8 <= clip_x0 || y >= clip_y1 || y + 8 <= clip_y0) {
+        return;
+    }
+    
+    int row0 = clip_y0 > y ? clip_y0 - y : 0;
+    int row1 = clip_y1 < y + 8 ? clip_y1 - y : 8;
+    int col0 = clip_x0 > x ? clip_x0 - x : 0;
+    int col1 = clip_x1 < x + 8 ? clip_x1 - x : 8;
+    
+    uint16_t *dst = framebuffer + (y + row0) * fb_stride + x;
+    for (int row = row0; row < row1; row++) {
+        const GlyphRowRuns *runs = &glyph_runs[glyph][row];
+        const uint16_t *src = glyph_pixels[slot][glyph][row];
+        
+        for (int k = 0; k < runs->count; k++) {
+            int start = runs->start[k];
+            int end = start + runs->len[k];
+            if (start < col0) start = col0;
+            if (end > col1) end = col1;
+            if (start < end) {
+                memcpy(dst + start, src + start, (end - start) * sizeof(uint16_t));
+            }
+        }
+        dst += fb_stride;
+    }
+}
+
+// Pede ao VideoCore um framebuffer com altura virtual dupla
+static bool allocate_framebuffer(void) {
+    int i = 0;
+    mbox[i++] = 0;                      // Tamanho (preenchido abaixo)
+    mbox[i++] = MAILBOX_REQUEST;
+    
+    mbox[i++] = TAG_SET_PHYSICAL_SIZE;
+    mbox[i++] = 8;
+    mbox[i++] = 8;
+    mbox[i++] = SCREEN_WIDTH;
+    mbox[i++] = SCREEN_HEIGHT;
+    
+    mbox[i++] = TAG_SET_VIRTUAL_SIZE;
+    mbox[i++] = 8;
+    mbox[i++] = 8;
+    mbox[i++] = SCREEN_WIDTH;
+    int virtual_height_index = i;
+    mbox[i++] = SCREEN_HEIGHT * 2;
+    
+    mbox[i++] = TAG_SET_VIRTUAL_OFFSET;
+    mbox[i++] = 8;
+    mbox[i++] = 8;
+    mbox[i++] = 0;
+    mbox[i++] = 0;
+    
+    mbox[i++] = TAG_SET_DEPTH;
+    mbox[i++] = 4;
+    mbox[i++] = 4;
+    int depth_index = i;
+    mbox[i++] = 16;                     // RGB565
+    
+    mbox[i++] = TAG_ALLOCATE_BUFFER;
+    mbox[i++] = 8;
+    mbox[i++] = 8;
+    int address_index = i;
+    mbox[i++] = 16;                     // Alinhamento pedido / endereço retornado
+    mbox[i++] = 0;                      // Tamanho retornado
+    
+    mbox[i++] = TAG_GET_PITCH;
+    mbox[i++] = 4;
+    mbox[i++] = 4;
+    int pitch_index = i;
+    mbox[i++] = 0;
+    
+    mbox[i++] = TAG_END;
+    mbox[0] = i * sizeof(uint32_t);
+    
+    if (!mailbox_call(MAILBOX_CHANNEL_PROPERTY, mbox)) {
+        return false;
+    }
+    if (mbox[depth_index] != 16 || mbox[address_index] == 0 || mbox[pitch_index] == 0) {
+        return false;
+    }
+    
+    fb_base = (uint16_t*)mailbox_bus_to_arm(mbox[address_index]);
+    fb_stride = mbox[pitch_index] / sizeof(uint16_t);
+    // A GPU pode recusar a altura virtual dupla: nesse caso, página única
+    fb_pages = mbox[virtual_height_index] >= SCREEN_HEIGHT * 2 ? 2 : 1;
+    return true;
+}
+
 void init_graphics(void) {
-    framebuffer = (uint16_t*)0x3C000000; // Endereço típico do framebuffer no RPi
-    graphics_clear_screen(BACKGROUND_COLOR);
+    if (!allocate_framebuffer()) {
+        // Sem resposta da GPU: endereço fixo e sem double buffering
+        fb_base = (uint16_t*)FRAMEBUFFER_ADDR;
+        fb_stride = SCREEN_WIDTH;
+        fb_pages = 1;
+    }
+    
+    // Limpar todas as páginas; desenhamos sempre na página que não está visível
+    for (fb_back_page = 0; fb_back_page < fb_pages; fb_back_page++) {
+        framebuffer = fb_base + fb_back_page * SCREEN_HEIGHT * fb_stride;
+        graphics_clear_screen(BACKGROUND_COLOR);
+    }
+    fb_back_page = fb_pages - 1;
+    framebuffer = fb_base + fb_back_page * SCREEN_HEIGHT * fb_stride;
+    
+    // Atlas de glifos para a cor de texto padrão
+    build_glyph_runs();
+    glyph_atlas_slot(TEXT_COLOR);
+}
+
+int graphics_page_count(void) {
+    return fb_pages;
+}
+
+void graphics_set_vsync(bool enabled) {
+    fb_vsync = enabled;
+}
+
+void graphics_set_clip(int x, int y, int width, int height) {
+    // Interseção com os limites da tela
+    clip_x0 = x < 0 ? 0 : x;
+    clip_y0 = y < 0 ? 0 : y;
+    clip_x1 = x + width > SCREEN_WIDTH ? SCREEN_WIDTH : x + width;
+    clip_y1 = y + height > SCREEN_HEIGHT ? SCREEN_HEIGHT : y + height;
+}
+
+void graphics_reset_clip(void) {
+    clip_x0 = 0;
+    clip_y0 = 0;
+    clip_x1 = SCREEN_WIDTH;
+    clip_y1 = SCREEN_HEIGHT;
 }
 
 void draw_pixel(int x, int y, uint16_t color) {
-    if (x >= 0 && x < SCREEN_WIDTH && y >= 0 && y < SCREEN_HEIGHT && framebuffer) {
-        framebuffer[y * SCREEN_WIDTH + x] = color;
+    if (x >= clip_x0 && x < clip_x1 && y >= clip_y0 && y < clip_y1 && framebuffer) {
+        framebuffer[y * fb_stride + x] = color;
     }
 }
 
+void graphics_fill_span(uint16_t *dst, int count, uint16_t color) {
+#if GRAPHICS_SPAN_FILL == SPAN_FILL_SCALAR
+    while (count-- > 0) {
+        *dst++ = color;
+    }
+#else
+    if (count <= 0) {
+        return;
+    }
+    
+    // Cabeça: alinhar em 4 bytes
+    if ((uintptr_t)dst & 2) {
+        *dst++ = color;
+        count--;
+    }
+    
+    uint32_t pair = (uint32_t)color | ((uint32_t)color << 16);
+    
+#if GRAPHICS_SPAN_FILL == SPAN_FILL_NEON
+    if (count >= 16) {
+        // Alinhar em 16 bytes e usar stores de 128 bits
+        while (((uintptr_t)dst & 15) && count >= 2) {
+            *(fb_word_t*)dst = pair;
+            dst += 2;
+            count -= 2;
+        }
+        uint16x8_t v = vdupq_n_u16(color);
+        while (count >= 32) {
+            vst1q_u16(dst, v);
+            vst1q_u16(dst + 8, v);
+            vst1q_u16(dst + 16, v);
+            vst1q_u16(dst + 24, v);
+            dst += 32;
+            count -= 32;
+        }
+        while (count >= 8) {
+            vst1q_u16(dst, v);
+            dst += 8;
+            count -= 8;
+        }
+    }
+#endif
+    
+    // Corpo: stores de 64 bits alinhados
+    if (count >= 2 && ((uintptr_t)dst & 4)) {
+        *(fb_word_t*)dst = pair;
+        dst += 2;
+        count -= 2;
+    }
+    uint64_t quad = (uint64_t)pair | ((uint64_t)pair << 32);
+    while (count >= 4) {
+        *(fb_dword_t*)dst = quad;
+        dst += 4;
+        count -= 4;
+    }
+    
+    // Cauda
+    if (count >= 2) {
+        *(fb_word_t*)dst = pair;
+        dst += 2;
+        count -= 2;
+    }
+    if (count) {
+        *dst = color;
+    }
+#endif
+}
+
 void graphics_clear_screen(uint16_t color) {
     if (!framebuffer) return;
     
-    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
-        framebuffer[i] = color;
+    if (fb_stride == SCREEN_WIDTH) {
+        graphics_fill_span(framebuffer, SCREEN_WIDTH * SCREEN_HEIGHT, color);
+        return;
+    }
+    for (int y = 0; y < SCREEN_HEIGHT; y++) {
+        graphics_fill_span(framebuffer + y * fb_stride, SCREEN_WIDTH, color);
     }
 }
 
 void graphics_draw_rect(int x, int y, int width, int height, uint16_t color) {
-    for (int dy = 0; dy < height; dy++) {
-        for (int dx = 0; dx < width; dx++) {
-            draw_pixel(x + dx, y + dy, color);
-        }
+    if (!framebuffer) return;
+    
+    // Recortar uma única vez contra a região ativa
+    int x0 = x < clip_x0 ? clip_x0 : x;
+    int y0 = y < clip_y0 ? clip_y0 : y;
+    int x1 = x + width > clip_x1 ? clip_x1 : x + width;
+    int y1 = y + height > clip_y1 ? clip_y1 : y + height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+    
+    uint16_t *row = framebuffer + y0 * fb_stride + x0;
+    for (int dy = y0; dy < y1; dy++) {
+        graphics_fill_span(row, x1 - x0, color);
+        row += fb_stride;
     }
 }
 
 void graphics_draw_rect_outline(int x, int y, int width, int height, uint16_t color) {
     // Top and bottom lines
-    for (int dx = 0; dx < width; dx++) {
-        draw_pixel(x + dx, y, color);
-        draw_pixel(x + dx, y + height - 1, color);
-    }
+    graphics_draw_rect(x, y, width, 1, color);
+    graphics_draw_rect(x, y + height - 1, width, 1, color);
     
     // Left and right lines
-    for (int dy = 1; dy < height - 1; dy++) {
-        draw_pixel(x, y + dy, color);
-        draw_pixel(x + width - 1, y + dy, color);
-    }
+    graphics_draw_rect(x, y + 1, 1, height - 2, color);
+    graphics_draw_rect(x + width - 1, y + 1, 1, height - 2, color);
 }
 
 void graphics_draw_char(int x, int y, char c, uint16_t color) {
     if (c < 32 || c > 126) return; // Apenas caracteres ASCII imprimíveis
+    if (!framebuffer) return;
     
-    const uint8_t *glyph = font_8x8[c - 32];
-    
-    for (int row = 0; row < 8; row++) {
-        uint8_t line = glyph[row];
-        for (int col = 0; col < 8; col++) {
-            if (line & (0x80 >> col)) {
-                draw_pixel(x + col, y + row, color);
-            }
-        }
-    }
+    blit_glyph(x, y, c - 32, glyph_atlas_slot(color));
 }
 
 void graphics_draw_string(int x, int y, const char *str, uint16_t color) {
+    if (!framebuffer) return;
+    
+    int slot = glyph_atlas_slot(color);
     int pos_x = x;
     while (*str) {
-        graphics_draw_char(pos_x, y, *str, color);
+        char c = *str;
+        if (c >= 32 && c <= 126) {
+            blit_glyph(pos_x, y, c - 32, slot);
+        }
         pos_x += 8;
         str++;
     }
 }
 
+bool graphics_text_cache_matches(const TextCache *cache, int x, int y, const char *str, uint16_t color) {
+    if (!cache->valid || cache->x != x || cache->y != y || cache->color != color) {
+        return false;
+    }
+    
+    int i = 0;
+    while (i < TEXT_CACHE_MAX_LEN - 1 && str[i] && cache->text[i] == str[i]) {
+        i++;
+    }
+    return cache->text[i] == str[i];
+}
+
+void graphics_text_cache_store(TextCache *cache, int x, int y, const char *str, uint16_t color) {
+    int i = 0;
+    while (i < TEXT_CACHE_MAX_LEN - 1 && str[i]) {
+        cache->text[i] = str[i];
+        i++;
+    }
+    cache->text[i] = '\0';
+    cache->x = x;
+    cache->y = y;
+    cache->width = i * 8;
+    cache->color = color;
+    cache->valid = true;
+}
+
 void graphics_draw_game_cell(int grid_x, int grid_y, uint16_t color) {
     int pixel_x = grid_x * CELL_SIZE;
     int pixel_y = grid_y * CELL_SIZE;
@@ -209,6 +538,37 @@ void graphics_draw_game_cell_bordered(int grid_x, int grid_y, uint16_t fill_colo
 }
 
 void graphics_swap_buffers(void) {
-    // Para implementação simples, não fazemos nada
-    // Em um sistema com double buffering, aqui trocaria os buffers
-}
\ No newline at end of file
+    if (fb_pages < 2) {
+        return;
+    }
+    
+    // Exibir a página recém-desenhada movendo o offset virtual
+    int i = 0;
+    mbox[i++] = 0;
+    mbox[i++] = MAILBOX_REQUEST;
+    
+    mbox[i++] = TAG_SET_VIRTUAL_OFFSET;
+    mbox[i++] = 8;
+    mbox[i++] = 8;
+    mbox[i++] = 0;
+    mbox[i++] = fb_back_page * SCREEN_HEIGHT;
+    
+    // Aguardar o vsync garante que a página antiga saiu da tela antes de reutilizá-la
+    if (fb_vsync) {
+        mbox[i++] = TAG_WAIT_FOR_VSYNC;
+        mbox[i++] = 4;
+        mbox[i++] = 4;
+        mbox[i++] = 0;
+    }
+    
+    mbox[i++] = TAG_END;
+    mbox[0] = i * sizeof(uint32_t);
+    
+    if (!mailbox_call(MAILBOX_CHANNEL_PROPERTY, mbox)) {
+        return;
+    }
+    
+    // A página que estava visível passa a ser a de trás
+    fb_back_page ^= 1;
+    framebuffer = fb_base + fb_back_page * SCREEN_HEIGHT * fb_stride;
+}
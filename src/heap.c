@@ -0,0 +1,502 @@
+//
+// heap.c - Alocador de uso geral (listas segregadas + coalescência)
+//
+
+#include <string.h>
+#include "heap.h"
+
+// ================================
+// BLOCOS
+// ================================
+
+// Cabeçalho de todo bloco. O tamanho inclui o cabeçalho e é múltiplo de 16;
+// os 4 bits baixos levam as flags.
+typedef struct {
+    uint32_t prev_size;         // Válido só quando o bloco anterior está livre
+    uint32_t size;
+} Block;
+
+// Bloco livre: os ponteiros da lista ocupam a carga útil
+typedef struct FreeBlock {
+    Block header;
+    struct FreeBlock *next;
+    struct FreeBlock *prev;
+} FreeBlock;
+
+#define BLOCK_USED          1u      // Entregue ou em lista rápida
+#define BLOCK_PREV_USED     2u      // Vizinho anterior não está livre
+#define BLOCK_QUICK         4u      // Em lista rápida
+#define BLOCK_FLAGS         15u
+
+#define HEADER_SIZE         sizeof(Block)
+#define MIN_BLOCK           32
+
+// Classes: exatas (passo de 16) abaixo de 1 KiB, depois 4 por potência de 2
+#define EXACT_LIMIT         1024
+#define EXACT_BINS          (EXACT_LIMIT / HEAP_ALIGN)
+#define NUM_BINS            (EXACT_BINS + 4 * 22)
+#define BITMAP_WORDS        ((NUM_BINS + 31) / 32)
+
+// Listas rápidas para blocos pequenos (até 256 bytes com cabeçalho)
+#define QUICK_MAX           256
+#define QUICK_LISTS         (QUICK_MAX / HEAP_ALIGN + 1)
+
+static Block *heap_first;
+static Block *heap_end;             // Sentinela: tamanho 0, sempre "usado"
+static FreeBlock *bins[NUM_BINS];
+static uint32_t bin_bitmap[BITMAP_WORDS];
+static FreeBlock *quick[QUICK_LISTS];
+
+static size_t heap_bytes;
+static size_t in_use;
+static size_t peak_in_use;
+static size_t quick_bytes;
+static uint32_t allocations;
+static uint32_t bin_blocks;
+static uint32_t quick_blocks;
+static uint32_t failed;
+
+static inline uint32_t block_size(const Block *b) {
+    return b->size & ~BLOCK_FLAGS;
+}
+
+static inline Block *next_block(Block *b) {
+    return (Block *)((uint8_t *)b + block_size(b));
+}
+
+static inline Block *prev_block(Block *b) {
+    return (Block *)((uint8_t *)b - b->prev_size);
+}
+
+static inline void *block_payload(Block *b) {
+    return (uint8_t *)b + HEADER_SIZE;
+}
+
+static inline Block *payload_block(const void *ptr) {
+    return (Block *)((uint8_t *)ptr - HEADER_SIZE);
+}
+
+// ================================
+// LISTAS POR CLASSE
+// ================================
+
+static unsigned bin_index(uint32_t size) {
+    if (size < EXACT_LIMIT) {
+        return size / HEAP_ALIGN;
+    }
+    unsigned log2 = 31 - __builtin_clz(size);
+    return EXACT_BINS + (log2 - 10) * 4 + ((size >> (log2 - 2)) & 3);
+}
+
+static void bin_insert(FreeBlock *b) {
+    unsigned i = bin_index(block_size(&b->header));
+    
+    b->prev = NULL;
+    b->next = bins[i];
+    if (bins[i]) {
+        bins[i]->prev = b;
+    }
+    bins[i] = b;
+    bin_bitmap[i / 32] |= 1u << (i % 32);
+    bin_blocks++;
+}
+
+static void bin_remove(FreeBlock *b) {
+    unsigned i = bin_index(block_size(&b->header));
+    
+    if (b->prev) {
+        b->prev->next = b->next;
+    } else {
+        bins[i] = b->next;
+    }
+    if (b->next) {
+        b->next->prev = b->prev;
+    }
+    if (!bins[i]) {
+        bin_bitmap[i / 32] &= ~(1u << (i % 32));
+    }
+    bin_blocks--;
+}
+
+// Primeira classe não vazia a partir de 'i' (NUM_BINS se nenhuma)
+static unsigned bin_next_nonempty(unsigned i) {
+    while (i < NUM_BINS) {
+        uint32_t bits = bin_bitmap[i / 32] & (~0u << (i % 32));
+        if (bits) {
+            return (i & ~31u) + __builtin_ctz(bits);
+        }
+        i = (i & ~31u) + 32;
+    }
+    return NUM_BINS;
+}
+
+// Bloco livre com pelo menos 'need' bytes
+static FreeBlock *find_free(uint32_t need) {
+    unsigned i = bin_index(need);
+    
+    // Nas classes logarítmicas a primeira pode ter blocos menores
+    if (i >= EXACT_BINS) {
+        for (FreeBlock *b = bins[i]; b; b = b->next) {
+            if (block_size(&b->header) >= need) {
+                return b;
+            }
+        }
+        i++;
+    }
+    
+    i = bin_next_nonempty(i);
+    return i < NUM_BINS ? bins[i] : NULL;
+}
+
+// ================================
+// LIBERAÇÃO E COALESCÊNCIA
+// ================================
+
+// Torna livre um bloco fora de qualquer lista, fundindo-o aos vizinhos livres
+static void release_block(Block *b) {
+    uint32_t size = block_size(b);
+    
+    if (!(b->size & BLOCK_PREV_USED)) {
+        Block *prev = prev_block(b);
+        bin_remove((FreeBlock *)prev);
+        size += block_size(prev);
+        b = prev;
+    }
+    
+    Block *next = (Block *)((uint8_t *)b + size);
+    if (!(next->size & BLOCK_USED)) {
+        bin_remove((FreeBlock *)next);
+        size += block_size(next);
+        next = (Block *)((uint8_t *)b + size);
+    }
+    
+    // Bloco anterior a um livre está sempre em uso (senão teria sido fundido)
+    b->size = size | BLOCK_PREV_USED;
+    next->prev_size = size;
+    next->size &= ~BLOCK_PREV_USED;
+    bin_insert((FreeBlock *)b);
+}
+
+// Devolve as listas rápidas às classes, coalescendo
+static void consolidate(void) {
+    for (unsigned i = 0; i < QUICK_LISTS; i++) {
+        while (quick[i]) {
+            FreeBlock *b = quick[i];
+            quick[i] = b->next;
+            quick_blocks--;
+            quick_bytes -= block_size(&b->header);
+            release_block(&b->header);
+        }
+    }
+}
+
+// Reduz um bloco em uso para 'need' bytes, liberando a sobra se couber um bloco
+static void trim_block(Block *b, uint32_t need) {
+    uint32_t size = block_size(b);
+    if (size - need < MIN_BLOCK) {
+        return;
+    }
+    
+    b->size = need | (b->size & BLOCK_FLAGS);
+    Block *rest = next_block(b);
+    rest->size = (size - need) | BLOCK_PREV_USED;
+    release_block(rest);
+}
+
+static void mark_used(Block *b) {
+    b->size |= BLOCK_USED;
+    next_block(b)->size |= BLOCK_PREV_USED;
+}
+
+static void account_alloc(Block *b) {
+    in_use += block_size(b);
+    allocations++;
+    if (in_use > peak_in_use) {
+        peak_in_use = in_use;
+    }
+}
+
+// ================================
+// API
+// ================================
+
+void heap_init(void *base, size_t size) {
+    memset(bins, 0, sizeof(bins));
+    memset(bin_bitmap, 0, sizeof(bin_bitmap));
+    memset(quick, 0, sizeof(quick));
+    in_use = peak_in_use = quick_bytes = 0;
+    allocations = bin_blocks = quick_blocks = failed = 0;
+    heap_bytes = 0;
+    heap_first = heap_end = NULL;
+    
+    // Cabeçalhos em endereços 8 mod 16: cargas úteis alinhadas em 16
+    uintptr_t start = (((uintptr_t)base + HEADER_SIZE + HEAP_ALIGN - 1) & ~(uintptr_t)(HEAP_ALIGN - 1)) - HEADER_SIZE;
+    uintptr_t limit = (uintptr_t)base + size;
+    if (limit < start + MIN_BLOCK + HEADER_SIZE) {
+        return;
+    }
+    
+    size_t total = (limit - HEADER_SIZE - start) & ~(size_t)(HEAP_ALIGN - 1);
+    if (total > 0xFFFFFFF0u) {
+        total = 0xFFFFFFF0u;
+    }
+    
+    heap_first = (Block *)start;
+    heap_end = (Block *)(start + total);
+    heap_end->size = BLOCK_USED;
+    heap_bytes = total;
+    
+    heap_first->size = (uint32_t)total | BLOCK_PREV_USED | BLOCK_USED;
+    release_block(heap_first);
+}
+
+void *heap_alloc(size_t size) {
+    if (!heap_first || size > heap_bytes) {
+        failed++;
+        return NULL;
+    }
+    
+    uint32_t need = (uint32_t)((size + HEADER_SIZE + HEAP_ALIGN - 1) & ~(size_t)(HEAP_ALIGN - 1));
+    if (need < MIN_BLOCK) {
+        need = MIN_BLOCK;
+    }
+    
+    // Caminho rápido: bloco pequeno do mesmo tamanho liberado há pouco
+    if (need <= QUICK_MAX && quick[need / HEAP_ALIGN]) {
+        FreeBlock *b = quick[need / HEAP_ALIGN];
+        quick[need / HEAP_ALIGN] = b->next;
+        quick_blocks--;
+        quick_bytes -= need;
+        b->header.size &= ~BLOCK_QUICK;
+        account_alloc(&b->header);
+        return block_payload(&b->header);
+    }
+    
+    FreeBlock *b = find_free(need);
+    if (!b && quick_blocks) {
+        consolidate();
+        b = find_free(need);
+    }
+    if (!b) {
+        failed++;
+        return NULL;
+    }
+    
+    bin_remove(b);
+    mark_used(&b->header);
+    trim_block(&b->header, need);
+    account_alloc(&b->header);
+    return block_payload(&b->header);
+}
+
+void *heap_alloc_aligned(size_t size, size_t align) {
+    if (align <= HEAP_ALIGN) {
+        return heap_alloc(size);
+    }
+    if (!heap_first || size > heap_bytes || align > heap_bytes) {
+        failed++;
+        return NULL;
+    }
+    
+    // Folga para achar um endereço alinhado que ainda deixe um bloco livre
+    // inteiro na frente
+    uint8_t *raw = heap_alloc(size + align + MIN_BLOCK);
+    if (!raw) {
+        return NULL;
+    }
+    
+    Block *b = payload_block(raw);
+    if ((uintptr_t)raw & (align - 1)) {
+        uintptr_t aligned = ((uintptr_t)raw + MIN_BLOCK + align - 1) & ~(uintptr_t)(align - 1);
+        uint32_t lead = (uint32_t)(aligned - (uintptr_t)raw);
+        uint32_t total = block_size(b);
+        
+        // A frente vira um bloco livre; o alinhado fica com o resto
+        Block *rest = payload_block((void *)aligned);
+        rest->size = (total - lead) | BLOCK_USED;
+        b->size = lead | (b->size & BLOCK_FLAGS);
+        release_block(b);
+        in_use -= lead;
+        b = rest;
+    }
+    
+    // Devolver a sobra do fim
+    uint32_t need = (uint32_t)((size + HEADER_SIZE + HEAP_ALIGN - 1) & ~(size_t)(HEAP_ALIGN - 1));
+    if (need < MIN_BLOCK) {
+        need = MIN_BLOCK;
+    }
+    uint32_t old_size = block_size(b);
+    trim_block(b, need);
+    in_use -= old_size - block_size(b);
+    return block_payload(b);
+}
+
+void heap_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    
+    Block *b = payload_block(ptr);
+    uint32_t size = block_size(b);
+    in_use -= size;
+    allocations--;
+    
+    if (size <= QUICK_MAX) {
+        FreeBlock *fb = (FreeBlock *)b;
+        b->size |= BLOCK_QUICK;
+        fb->next = quick[size / HEAP_ALIGN];
+        quick[size / HEAP_ALIGN] = fb;
+        quick_blocks++;
+        quick_bytes += size;
+        return;
+    }
+    
+    release_block(b);
+}
+
+void *heap_calloc(size_t count, size_t size) {
+    if (size && count > (size_t)-1 / size) {
+        failed++;
+        return NULL;
+    }
+    
+    void *ptr = heap_alloc(count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void *heap_realloc(void *ptr, size_t size) {
+    return heap_realloc_aligned(ptr, size, HEAP_ALIGN);
+}
+
+void *heap_realloc_aligned(void *ptr, size_t size, size_t align) {
+    if (!ptr) {
+        return heap_alloc_aligned(size, align);
+    }
+    if (size == 0) {
+        heap_free(ptr);
+        return NULL;
+    }
+    if (size > heap_bytes) {
+        failed++;
+        return NULL;
+    }
+    
+    Block *b = payload_block(ptr);
+    uint32_t old_size = block_size(b);
+    uint32_t need = (uint32_t)((size + HEADER_SIZE + HEAP_ALIGN - 1) & ~(size_t)(HEAP_ALIGN - 1));
+    if (need < MIN_BLOCK) {
+        need = MIN_BLOCK;
+    }
+    
+    // Encolher (ou já cabe): devolver a sobra
+    if (need <= old_size) {
+        trim_block(b, need);
+        in_use -= old_size - block_size(b);
+        return ptr;
+    }
+    
+    // Crescer no lugar absorvendo o vizinho livre
+    Block *next = next_block(b);
+    if (!(next->size & BLOCK_USED) && old_size + block_size(next) >= need) {
+        bin_remove((FreeBlock *)next);
+        b->size = (old_size + block_size(next)) | (b->size & BLOCK_FLAGS);
+        next_block(b)->size |= BLOCK_PREV_USED;
+        trim_block(b, need);
+        
+        in_use += block_size(b) - old_size;
+        if (in_use > peak_in_use) {
+            peak_in_use = in_use;
+        }
+        return ptr;
+    }
+    
+    // Mover: copia só a carga útil antiga. No lugar o início não muda e o
+    // alinhamento se mantém; aqui ele é pedido de novo.
+    void *moved = heap_alloc_aligned(size, align);
+    if (!moved) {
+        return NULL;
+    }
+    memcpy(moved, ptr, old_size - HEADER_SIZE);
+    heap_free(ptr);
+    return moved;
+}
+
+size_t heap_usable_size(const void *ptr) {
+    return ptr ? block_size(payload_block(ptr)) - HEADER_SIZE : 0;
+}
+
+void heap_get_stats(MemStats *stats) {
+    size_t largest = 0;
+    
+    // O maior bloco está na classe não vazia mais alta
+    for (int i = NUM_BINS - 1; i >= 0; i--) {
+        if (bins[i]) {
+            for (FreeBlock *b = bins[i]; b; b = b->next) {
+                if (block_size(&b->header) > largest) {
+                    largest = block_size(&b->header);
+                }
+            }
+            break;
+        }
+    }
+    
+    stats->size = heap_bytes;
+    stats->in_use = in_use;
+    stats->peak_in_use = peak_in_use;
+    stats->free_bytes = heap_bytes - in_use;
+    stats->largest_free = largest;
+    stats->allocations = allocations;
+    stats->free_blocks = bin_blocks + quick_blocks;
+    stats->failed = failed;
+    stats->fragmentation_pct = stats->free_bytes ?
+        (uint32_t)(100 - (largest * 100) / stats->free_bytes) : 0;
+}
+
+bool heap_check(void) {
+    if (!heap_first) {
+        return true;
+    }
+    
+    size_t used = 0;
+    size_t total = 0;
+    uint32_t free_count = 0;
+    uint32_t quick_count = 0;
+    bool prev_used = true;
+    uint32_t prev_size = 0;
+    
+    for (Block *b = heap_first; b != heap_end; b = next_block(b)) {
+        uint32_t size = block_size(b);
+        if (size < MIN_BLOCK || size % HEAP_ALIGN || (uint8_t *)b + size > (uint8_t *)heap_end) {
+            return false;
+        }
+        if (!!(b->size & BLOCK_PREV_USED) != prev_used) {
+            return false;
+        }
+        if (!prev_used && b->prev_size != prev_size) {
+            return false;
+        }
+        
+        bool is_used = b->size & BLOCK_USED;
+        if (!is_used && !prev_used) {
+            return false;   // Dois livres vizinhos: coalescência falhou
+        }
+        if (b->size & BLOCK_QUICK) {
+            quick_count++;
+        } else if (is_used) {
+            used += size;
+        } else {
+            free_count++;
+        }
+        
+        total += size;
+        prev_used = is_used;
+        prev_size = size;
+    }
+    
+    return total == heap_bytes && used == in_use &&
+           free_count == bin_blocks && quick_count == quick_blocks &&
+           !!(heap_end->size & BLOCK_PREV_USED) == prev_used;
+}
@@ -0,0 +1,17 @@
+#ifndef AEABI_HOST_H
+#define AEABI_HOST_H
+
+#include <stdint.h>
+
+// Rotinas de aeabi_div.c, chamadas diretamente pelos testes do host (no Pi
+// só o compilador as chama). No host não há __ARM_FEATURE_IDIV: roda o
+// caminho em software (CLZ + subtração).
+
+unsigned int __aeabi_uidiv(unsigned int numerator, unsigned int denominator);
+uint64_t __aeabi_uidivmod(unsigned int numerator, unsigned int denominator);
+int __aeabi_idiv(int numerator, int denominator);
+uint64_t __aeabi_idivmod(int numerator, int denominator);
+uint64_t aeabi_uldivmod_c(uint64_t numerator, uint64_t denominator, uint64_t *remainder);
+int64_t aeabi_ldivmod_c(int64_t numerator, int64_t denominator, int64_t *remainder);
+
+#endif // AEABI_HOST_H
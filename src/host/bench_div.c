@@ -0,0 +1,119 @@
+//
+// bench_div.c - Custo das divisões do AEABI (ns por divisão)
+//
+// No host roda o caminho em software de aeabi_div.c (CLZ + subtração),
+// ao lado da instrução de divisão nativa como escala. O custo depende da
+// diferença de magnitude entre dividendo e divisor: quocientes pequenos
+// (índices, coordenadas) e grandes (conversões de tempo) são medidos à
+// parte.
+//
+
+#include "aeabi_host.h"
+#include "test.h"
+
+#define COUNT   4096
+#define ROUNDS  500
+
+static uint64_t numerators[COUNT];
+static uint64_t denominators[COUNT];
+static volatile uint64_t sink;
+
+static uint64_t random_state = 88172645463325252ull;
+
+static uint64_t random64(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Quocientes de até 'quotient_bits' bits, com operandos de 'bits' bits
+static void prepare(unsigned bits, unsigned quotient_bits) {
+    for (int i = 0; i < COUNT; i++) {
+        uint64_t d = (random64() >> (64 - (bits - quotient_bits))) | 1;
+        uint64_t q = random64() >> (64 - quotient_bits);
+        numerators[i] = d * q + (random64() % d);
+        denominators[i] = d;
+    }
+}
+
+static double per_division(uint64_t start) {
+    return (double)(test_now_ns() - start) / ((double)COUNT * ROUNDS);
+}
+
+static void bench_32(const char *name, unsigned quotient_bits) {
+    prepare(32, quotient_bits);
+    uint64_t acc = 0;
+    
+    uint64_t start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += __aeabi_uidiv((uint32_t)numerators[i], (uint32_t)denominators[i]);
+        }
+    }
+    double uidiv = per_division(start);
+    
+    start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += __aeabi_idiv((int32_t)numerators[i] >> 1, (int32_t)denominators[i]);
+        }
+    }
+    double idiv = per_division(start);
+    
+    start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += (uint32_t)numerators[i] / (uint32_t)denominators[i];
+        }
+    }
+    double native = per_division(start);
+    
+    sink = acc;
+    printf("  32 bits, %-10s uidiv %6.2f  idiv %6.2f  nativo %6.2f\n", name, uidiv, idiv, native);
+}
+
+static void bench_64(const char *name, unsigned quotient_bits) {
+    prepare(64, quotient_bits);
+    uint64_t acc = 0;
+    uint64_t r64;
+    int64_t s64;
+    
+    uint64_t start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += aeabi_uldivmod_c(numerators[i], denominators[i], &r64) + r64;
+        }
+    }
+    double uldivmod = per_division(start);
+    
+    start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += aeabi_ldivmod_c(-(int64_t)(numerators[i] >> 1), (int64_t)denominators[i], &s64) + s64;
+        }
+    }
+    double ldivmod = per_division(start);
+    
+    start = test_now_ns();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < COUNT; i++) {
+            acc += numerators[i] / denominators[i] + numerators[i] % denominators[i];
+        }
+    }
+    double native = per_division(start);
+    
+    sink = acc;
+    printf("  64 bits, %-10s uldivmod %6.2f  ldivmod %6.2f  nativo %6.2f\n", name, uldivmod, ldivmod, native);
+}
+
+int main(void) {
+    printf("bench_div (ns/divisão)\n");
+    bench_32("q < 2^4", 4);
+    bench_32("q < 2^16", 16);
+    bench_32("q < 2^31", 31);
+    bench_64("q < 2^8", 8);
+    bench_64("q < 2^32", 32);
+    bench_64("q < 2^63", 63);
+    return 0;
+}
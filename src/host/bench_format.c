@@ -0,0 +1,73 @@
+//
+// bench_format.c - vformat() ao lado do vsnprintf da glibc (ns por chamada)
+//
+// Linhas típicas do console: placar, relatórios de estatística e
+// hexdump, além de inteiros de 64 bits, que vformat converte sem divisão
+// de 64 bits.
+//
+
+#include <stdio.h>
+#include "format_host.h"
+#include "test.h"
+
+#define ROUNDS  2000000
+
+static volatile int sink_total;
+
+static int libc_format(char *out, size_t size, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(out, size, format, args);
+    va_end(args);
+    return n;
+}
+
+static int our_format(char *out, size_t size, const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+    int n = format_buffer_v(out, size, format, args);
+    va_end(args);
+    return n;
+}
+
+typedef int Formatter(char *out, size_t size, const char *format, ...);
+
+static double run(Formatter *format, int which) {
+    char out[256];
+    int total = 0;
+    uint64_t start = test_now_ns();
+    
+    for (uint32_t i = 0; i < ROUNDS; i++) {
+        switch (which) {
+            case 0:
+                total += format(out, sizeof(out), "Score: %d", (int)i);
+                break;
+            case 1:
+                total += format(out, sizeof(out), "%s: em uso %u B (pico %u B) de %u B, falhas %u",
+                                "Heap", i, i * 3, 1u << 20, i & 7);
+                break;
+            case 2:
+                total += format(out, sizeof(out), "%04x: %02x %02x %02x %02x ",
+                                i & 0xFFFF, i & 0xFF, (i >> 8) & 0xFF, (i >> 16) & 0xFF, 0x41);
+                break;
+            default:
+                total += format(out, sizeof(out), "%llu us, %lld",
+                                (unsigned long long)i * 123456789012ull, -(long long)i * 987654321ll);
+                break;
+        }
+    }
+    sink_total += total;
+    return (double)(test_now_ns() - start) / ROUNDS;
+}
+
+int main(void) {
+    static const char *const names[] = {"placar", "estatística", "hexdump", "64 bits"};
+    
+    printf("bench_format (ns/chamada: vformat / glibc)\n");
+    for (int which = 0; which < 4; which++) {
+        double ours = run(our_format, which);
+        double libc = run(libc_format, which);
+        printf("  %6.1f / %6.1f  %s\n", ours, libc, names[which]);
+    }
+    return 0;
+}
@@ -0,0 +1,150 @@
+//
+// bench_game.c - Colisão e comida pelo mapa de ocupação contra a busca linear
+//
+// A cobra segue o ciclo hamiltoniano até quase encher o tabuleiro. Em cada
+// comprimento marcado, mede o custo por passo das duas consultas que a
+// simulação faz: a colisão da nova cabeça (check_collision contra a busca
+// nos segmentos) e o sorteio da comida (spawn_food contra o sorteio com
+// nova tentativa a cada célula ocupada, que era como a comida nascia).
+//
+
+#include "game.h"
+#include "test.h"
+
+#define COLLISION_CHECKS    200000
+#define SPAWN_CALLS         200
+
+static Game game;
+static Game scratch;
+
+// Mesmo ciclo do test_game.c: linhas ímpares para a direita, pares para a
+// esquerda a partir de x = 1, voltando pela coluna 0
+static Direction cycle_direction(Position head) {
+    if (head.x == 0) {
+        return head.y == GAME_HEIGHT - 1 ? DIR_RIGHT : DIR_DOWN;
+    }
+    if (head.y % 2 == 1) {
+        return head.x < GAME_WIDTH - 1 ? DIR_RIGHT : DIR_UP;
+    }
+    if (head.x > 1) {
+        return DIR_LEFT;
+    }
+    return head.y == 0 ? DIR_LEFT : DIR_UP;
+}
+
+static Position step_from(Position pos, Direction dir) {
+    switch (dir) {
+        case DIR_UP:    pos.y--; break;
+        case DIR_DOWN:  pos.y++; break;
+        case DIR_LEFT:  pos.x--; break;
+        case DIR_RIGHT: pos.x++; break;
+    }
+    return pos;
+}
+
+// Referências pela busca linear nos segmentos
+static bool scan_occupies(const Snake *snake, Position pos) {
+    for (int i = 0; i < snake->length; i++) {
+        Position p = snake_segment(snake, i);
+        if (p.x == pos.x && p.y == pos.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool scan_collision(const Game *g, Position pos) {
+    if (pos.x < 0 || pos.x >= GAME_WIDTH || pos.y < 0 || pos.y >= GAME_HEIGHT) {
+        return true;
+    }
+    for (int i = 1; i < g->snake.length; i++) {
+        Position p = snake_segment(&g->snake, i);
+        if (p.x == pos.x && p.y == pos.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void scan_spawn_food(Game *g) {
+    do {
+        int cell = (int)rng_range(&g->rng, GRID_CELLS);
+        g->food.x = cell % GAME_WIDTH;
+        g->food.y = cell / GAME_WIDTH;
+    } while (scan_occupies(&g->snake, g->food));
+}
+
+// Ponteiros voláteis: o laço não pode tirar a consulta de dentro dele
+static double collision_ns(bool (*volatile collide)(const Game *, Position), Position pos) {
+    unsigned hits = 0;
+    uint64_t start = test_now_ns();
+    for (int i = 0; i < COLLISION_CHECKS; i++) {
+        hits += collide(&game, pos);
+    }
+    uint64_t ns = test_now_ns() - start;
+    
+    // A nova cabeça do ciclo nunca colide
+    CHECK_EQ(hits, 0);
+    return (double)ns / COLLISION_CHECKS;
+}
+
+static double spawn_ns(void (*volatile spawn)(Game *)) {
+    scratch = game;
+    uint64_t start = test_now_ns();
+    for (int i = 0; i < SPAWN_CALLS; i++) {
+        spawn(&scratch);
+    }
+    uint64_t ns = test_now_ns() - start;
+    
+    CHECK(!scan_occupies(&scratch.snake, scratch.food));
+    return (double)ns / SPAWN_CALLS;
+}
+
+// Avança pelo ciclo até o comprimento pedido; devolve os passos dados
+static uint32_t grow_to(int length, uint64_t *step_ns) {
+    static const unsigned char keys[] = {KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1};
+    uint32_t steps = 0;
+    
+    uint64_t start = test_now_ns();
+    while (game.state == GAME_RUNNING && game.snake.length < length) {
+        Direction dir = cycle_direction(game.snake.body[game.snake.head]);
+        if (dir != game.snake.direction) {
+            handle_input(&game, keys[dir]);
+        }
+        game_step(&game);
+        steps++;
+    }
+    *step_ns += test_now_ns() - start;
+    return steps;
+}
+
+int main(void) {
+    static const int lengths[] = {
+        GRID_CELLS / 4, GRID_CELLS / 2, GRID_CELLS * 3 / 4,
+        GRID_CELLS - 50, GRID_CELLS - 10, GRID_CELLS - 1
+    };
+    uint64_t step_ns = 0;
+    uint32_t steps = 0;
+    
+    game_seed(&game, 11);
+    init_game(&game);
+    
+    printf("bench_game (ns por passo: mapa / busca linear)\n");
+    for (unsigned i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        steps += grow_to(lengths[i], &step_ns);
+        if (game.snake.length != lengths[i]) {
+            fprintf(stderr, "comprimento %d, esperado %d\n", game.snake.length, lengths[i]);
+            return 1;
+        }
+        
+        Position head = game.snake.body[game.snake.head];
+        Position next = step_from(head, cycle_direction(head));
+        printf("  %4d/%d células  colisão %6.1f / %-9.1f  comida %6.1f / %.1f\n",
+               game.snake.length, GRID_CELLS,
+               collision_ns(check_collision, next), collision_ns(scan_collision, next),
+               spawn_ns(spawn_food), spawn_ns(scan_spawn_food));
+    }
+    printf("  game_step: %.1f ns/passo em %u passos\n", (double)step_ns / steps, steps);
+    
+    return test_failures ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+//
+// bench_graphics.c - Vazão do preenchimento de spans (megapixels/s)
+//
+// Ligado uma vez por variante de GRAPHICS_SPAN_FILL (make bench). No host
+// a variante NEON não existe; no Pi o mesmo laço vale para as três.
+//
+
+#include "graphics.h"
+#include "test.h"
+
+#define TARGET_PIXELS   (200u * 1000 * 1000)
+
+static double mpixels_per_s(uint64_t pixels, uint64_t ns) {
+    return ns ? pixels * 1000.0 / ns : 0.0;
+}
+
+static void bench_span(int width) {
+    int rows = SCREEN_HEIGHT;
+    uint32_t rounds = TARGET_PIXELS / ((uint32_t)width * rows);
+    uint64_t start = test_now_ns();
+    
+    for (uint32_t r = 0; r < rounds; r++) {
+        uint16_t *row = framebuffer + (r & 7);
+        for (int y = 0; y < rows; y++) {
+            graphics_fill_span(row, width, (uint16_t)r);
+            row += SCREEN_WIDTH;
+        }
+    }
+    
+    uint64_t pixels = (uint64_t)rounds * width * rows;
+    printf("  span %3d px    %8.1f Mpx/s\n", width, mpixels_per_s(pixels, test_now_ns() - start));
+}
+
+// Células do tabuleiro: o caso comum do draw_game
+static void bench_cells(void) {
+    uint32_t cells = TARGET_PIXELS / (CELL_SIZE * CELL_SIZE);
+    uint64_t start = test_now_ns();
+    
+    for (uint32_t i = 0; i < cells; i++) {
+        graphics_draw_game_cell(i % GAME_WIDTH, (i / GAME_WIDTH) % GAME_HEIGHT, (uint16_t)i);
+    }
+    
+    uint64_t pixels = (uint64_t)cells * CELL_SIZE * CELL_SIZE;
+    printf("  célula %dx%d   %8.1f Mpx/s\n", CELL_SIZE, CELL_SIZE,
+           mpixels_per_s(pixels, test_now_ns() - start));
+}
+
+static void bench_clear(void) {
+    uint32_t rounds = TARGET_PIXELS / (SCREEN_WIDTH * SCREEN_HEIGHT);
+    uint64_t start = test_now_ns();
+    
+    for (uint32_t i = 0; i < rounds; i++) {
+        graphics_clear_screen((uint16_t)i);
+    }
+    
+    uint64_t pixels = (uint64_t)rounds * SCREEN_WIDTH * SCREEN_HEIGHT;
+    printf("  tela inteira   %8.1f Mpx/s\n", mpixels_per_s(pixels, test_now_ns() - start));
+}
+
+int main(void) {
+    static const char *names[] = {"escalar", "32/64 bits", "NEON"};
+    
+    init_graphics();
+    printf("bench_graphics (%s)\n", names[GRAPHICS_SPAN_FILL]);
+    bench_span(8);
+    bench_span(16);
+    bench_span(64);
+    bench_span(SCREEN_WIDTH - 8);
+    bench_cells();
+    bench_clear();
+    return 0;
+}
@@ -0,0 +1,57 @@
+//
+// bench_memops.c - Vazão do memops.c ao lado da libc do host (MB/s)
+//
+// No host o memops.c roda sem NEON, com os mesmos caminhos de 32/64 bits
+// do Pi; a libc usa instruções vetoriais largas e serve só de escala.
+//
+
+#include <string.h>
+#include "memops_host.h"
+#include "test.h"
+
+#define TARGET_BYTES    (1024u * 1024 * 1024)
+#define BUFFER_SIZE     (64 * 1024 + 64)
+
+typedef void *CopyFunction(void *dest, const void *src, size_t n);
+
+static uint8_t source[BUFFER_SIZE] __attribute__((aligned(64)));
+static uint8_t dest[BUFFER_SIZE] __attribute__((aligned(64)));
+
+static double mbytes_per_s(uint64_t bytes, uint64_t ns) {
+    return ns ? bytes * 1000.0 / ns : 0.0;
+}
+
+// Ponteiro volátil: impede o compilador de trocar a chamada pelo builtin
+static double run_copy(CopyFunction *volatile copy, size_t size, int misalign) {
+    uint32_t rounds = TARGET_BYTES / size;
+    uint64_t start = test_now_ns();
+    for (uint32_t i = 0; i < rounds; i++) {
+        copy(dest, source + misalign, size);
+    }
+    return mbytes_per_s((uint64_t)rounds * size, test_now_ns() - start);
+}
+
+static double run_set(void *(*volatile set)(void *, int, size_t), size_t size) {
+    uint32_t rounds = TARGET_BYTES / size;
+    uint64_t start = test_now_ns();
+    for (uint32_t i = 0; i < rounds; i++) {
+        set(dest, (int)i, size);
+    }
+    return mbytes_per_s((uint64_t)rounds * size, test_now_ns() - start);
+}
+
+int main(void) {
+    static const size_t sizes[] = {16, 64, 256, 4096, 64 * 1024};
+    
+    printf("bench_memops (MB/s: memops / libc)\n");
+    for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        size_t n = sizes[i];
+        printf("  %6zu B  memcpy %8.0f / %-8.0f  desalinhado %8.0f / %-8.0f  memmove %8.0f / %-8.0f  memset %8.0f / %-8.0f\n",
+               n,
+               run_copy(memops_memcpy, n, 0), run_copy(memcpy, n, 0),
+               run_copy(memops_memcpy, n, 3), run_copy(memcpy, n, 3),
+               run_copy(memops_memmove, n, 1), run_copy(memmove, n, 1),
+               run_set(memops_memset, n), run_set(memset, n));
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+//
+// bench_pool.c - Pools e arena de frame contra o heap do malloc (ns por par)
+//
+// O malloc do kernel (syscalls.c) cai no heap.c quando o pool não atende;
+// no Pi ele ainda mascara IRQ em volta, o que aqui fica de fora. A libc
+// do host entra só como escala.
+//
+//   rotatividade  N blocos de 64 bytes vivos; cada operação libera um ao
+//                 acaso e aloca outro no lugar (requisições USB)
+//   frame         FRAME_ALLOCS pedidos de 16 a 128 bytes e, no fim, tudo
+//                 devolvido: arena_reset contra um free por bloco
+//
+
+#include <stdlib.h>
+#include "arena.h"
+#include "heap.h"
+#include "pool.h"
+#include "test.h"
+
+#define OPERATIONS      4000000
+#define BLOCK_SIZE      64
+#define MAX_LIVE        4096
+#define FRAME_ALLOCS    64
+#define FRAMES          (OPERATIONS / FRAME_ALLOCS)
+#define HEAP_SIZE       (1024 * 1024)
+#define ARENA_SIZE      (FRAME_ALLOCS * 128)
+
+static uint8_t pool_memory[POOL_REGION_SIZE(BLOCK_SIZE, MAX_LIVE)] __attribute__((aligned(POOL_ALIGN)));
+static uint8_t heap_memory[HEAP_SIZE] __attribute__((aligned(HEAP_ALIGN)));
+static uint8_t arena_memory[ARENA_SIZE] __attribute__((aligned(ARENA_ALIGN)));
+static void *live[MAX_LIVE];
+static uint8_t frame_sizes[FRAME_ALLOCS];
+
+typedef enum { USE_POOL, USE_HEAP, USE_LIBC } Allocator;
+
+static Pool pool;
+
+static uint32_t random_state = 3;
+
+static uint32_t bench_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+static void *block_alloc(Allocator which, size_t size) {
+    switch (which) {
+        case USE_POOL: return pool_alloc(&pool);
+        case USE_HEAP: return heap_alloc(size);
+        default:       return malloc(size);
+    }
+}
+
+static void block_free(Allocator which, void *ptr) {
+    switch (which) {
+        case USE_POOL: pool_free(&pool, ptr); break;
+        case USE_HEAP: heap_free(ptr); break;
+        default:       free(ptr); break;
+    }
+}
+
+static double churn_ns(Allocator which, uint32_t count) {
+    pool_init(&pool, pool_memory, BLOCK_SIZE, MAX_LIVE);
+    heap_init(heap_memory, HEAP_SIZE);
+    random_state = 3;
+    for (uint32_t i = 0; i < count; i++) {
+        live[i] = block_alloc(which, BLOCK_SIZE);
+    }
+    
+    uint64_t start = test_now_ns();
+    for (uint32_t op = 0; op < OPERATIONS; op++) {
+        uint32_t slot = bench_random() % count;
+        block_free(which, live[slot]);
+        live[slot] = block_alloc(which, BLOCK_SIZE);
+        *(volatile uint8_t *)live[slot] = (uint8_t)op;
+    }
+    uint64_t ns = test_now_ns() - start;
+    
+    for (uint32_t i = 0; i < count; i++) {
+        block_free(which, live[i]);
+    }
+    return (double)ns / OPERATIONS;
+}
+
+// Heap e libc: um free por bloco no fim do frame
+static double frame_free_ns(Allocator which) {
+    heap_init(heap_memory, HEAP_SIZE);
+    
+    uint64_t start = test_now_ns();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        for (int i = 0; i < FRAME_ALLOCS; i++) {
+            live[i] = block_alloc(which, frame_sizes[i]);
+            *(volatile uint8_t *)live[i] = (uint8_t)i;
+        }
+        for (int i = 0; i < FRAME_ALLOCS; i++) {
+            block_free(which, live[i]);
+        }
+    }
+    return (double)(test_now_ns() - start) / (FRAMES * FRAME_ALLOCS);
+}
+
+static double frame_arena_ns(void) {
+    Arena arena;
+    arena_init(&arena, arena_memory, ARENA_SIZE);
+    
+    uint64_t start = test_now_ns();
+    for (uint32_t frame = 0; frame < FRAMES; frame++) {
+        for (int i = 0; i < FRAME_ALLOCS; i++) {
+            live[i] = arena_alloc(&arena, frame_sizes[i]);
+            *(volatile uint8_t *)live[i] = (uint8_t)i;
+        }
+        arena_reset(&arena);
+    }
+    uint64_t ns = test_now_ns() - start;
+    
+    CHECK_EQ(arena.failed, 0);
+    return (double)ns / (FRAMES * FRAME_ALLOCS);
+}
+
+int main(void) {
+    static const uint32_t counts[] = {16, 256, MAX_LIVE};
+    
+    printf("bench_pool (ns por alocação + liberação: pool ou arena / heap / libc)\n");
+    for (unsigned i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        uint32_t count = counts[i];
+        printf("  rotatividade %4u vivos  %6.1f / %6.1f / %6.1f\n", count,
+               churn_ns(USE_POOL, count), churn_ns(USE_HEAP, count), churn_ns(USE_LIBC, count));
+    }
+    
+    for (int i = 0; i < FRAME_ALLOCS; i++) {
+        frame_sizes[i] = (uint8_t)(16 + bench_random() % 113);
+    }
+    printf("  frame de %d pedidos       %6.1f / %6.1f / %6.1f\n", FRAME_ALLOCS,
+           frame_arena_ns(), frame_free_ns(USE_HEAP), frame_free_ns(USE_LIBC));
+    
+    return test_failures ? 1 : 0;
+}
@@ -0,0 +1,56 @@
+//
+// bench_text.c - Glifos por segundo: atlas contra o desenho bit a bit
+//
+
+#include "../graphics.c"    // font_8x8 é interno
+
+#include "test.h"
+
+#define GLYPHS          (4u * 1000 * 1000)
+
+static void bit_test_draw_char(int x, int y, char c, uint16_t color) {
+    if (c < 32 || c > 126) return;
+    
+    const uint8_t *glyph = font_8x8[c - 32];
+    for (int row = 0; row < 8; row++) {
+        uint8_t line = glyph[row];
+        for (int col = 0; col < 8; col++) {
+            if (line & (0x80 >> col)) {
+                draw_pixel(x + col, y + row, color);
+            }
+        }
+    }
+}
+
+static void report(const char *name, uint64_t ns) {
+    printf("  %-12s %8.2f Mglifos/s  %6.1f ns/glifo\n", name,
+           GLYPHS * 1000.0 / ns, (double)ns / GLYPHS);
+}
+
+int main(void) {
+    const char *text = "Score: 1230 GAME OVER Press R to restart";
+    int len = (int)strlen(text);
+    
+    init_graphics();
+    printf("bench_text\n");
+    
+    uint64_t start = test_now_ns();
+    for (uint32_t i = 0; i < GLYPHS; i++) {
+        bit_test_draw_char((i % 79) * 8, (i / 79 % 59) * 8, text[i % len], TEXT_COLOR);
+    }
+    report("bit a bit", test_now_ns() - start);
+    
+    start = test_now_ns();
+    for (uint32_t i = 0; i < GLYPHS; i++) {
+        graphics_draw_char((i % 79) * 8, (i / 79 % 59) * 8, text[i % len], TEXT_COLOR);
+    }
+    report("atlas", test_now_ns() - start);
+    
+    // Strings inteiras: um slot do atlas por chamada
+    start = test_now_ns();
+    for (uint32_t i = 0; i < GLYPHS / len; i++) {
+        graphics_draw_string(0, (i % 59) * 8, text, TEXT_COLOR);
+    }
+    report("atlas/string", (test_now_ns() - start) * GLYPHS / (GLYPHS / len * len));
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef FORMAT_HOST_H
+#define FORMAT_HOST_H
+
+#include <stdarg.h>
+#include <string.h>
+#include "format.h"
+
+// vformat() num buffer de tamanho fixo, para comparar com o vsnprintf do
+// host nos testes e benchmarks. A saída é cortada em 'size' - 1 bytes, como
+// no snprintf; o retorno é o total que vformat produziu.
+
+typedef struct {
+    char *data;
+    size_t size;
+    size_t used;
+} FormatBuffer;
+
+static void format_buffer_sink(void *context, const char *data, size_t len) {
+    FormatBuffer *buffer = context;
+    size_t room = buffer->size - 1 - buffer->used;
+    size_t n = len < room ? len : room;
+    memcpy(buffer->data + buffer->used, data, n);
+    buffer->used += n;
+}
+
+static inline int format_buffer_v(char *out, size_t size, const char *format, va_list args) {
+    FormatBuffer buffer = { out, size, 0 };
+    int count = vformat(format_buffer_sink, &buffer, format, args);
+    out[buffer.used] = '\0';
+    return count;
+}
+
+#endif // FORMAT_HOST_H
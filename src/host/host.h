@@ -0,0 +1,38 @@
+#ifndef HOST_H
+#define HOST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Controle do ambiente simulado (build host)
+
+// Relógio virtual: o tempo só anda quando o simulador manda
+void host_set_ticks(uint32_t ticks);
+void host_advance_ticks(uint32_t ms);
+void host_advance_us(uint64_t us);     // Simula custo de trabalho (ex.: render)
+
+// Relatórios HID entregues ao jogo por platform_poll_input(), como o
+// handler da USPi faria; host_push_key() é um toque (pressiona e solta)
+void host_push_report(uint8_t modifiers, const uint8_t keys[6]);
+void host_push_key(unsigned char key);
+
+// Estado do VideoCore simulado
+uint16_t *host_display_page(void);      // Página atualmente exibida
+uint32_t host_display_offset(void);     // Offset virtual Y atual
+unsigned host_vsync_count(void);
+
+// Maior altura virtual que a GPU simulada aceita (padrão: duas páginas);
+// com SCREEN_HEIGHT ela recusa o double buffering
+void host_set_virtual_height_limit(uint32_t height);
+
+// Controlador de interrupções simulado: registradores lidos e escritos
+// por interrupts.c, linhas pendentes levantadas pelo teste. Como no
+// hardware, a linha fica pendente até o "dispositivo" (o handler) limpar.
+uint32_t host_irq_read(uint32_t offset);
+void host_irq_write(uint32_t offset, uint32_t value);
+void host_irq_raise(unsigned irq);
+void host_irq_clear(unsigned irq);
+void host_irq_enable(unsigned irq);     // Sem handler, como o firmware faria
+bool host_irq_enabled(unsigned irq);
+
+#endif // HOST_H
@@ -0,0 +1,63 @@
+//
+// interrupts_host.c - Controlador de interrupções simulado para o build host
+// Mesmo mapa de registradores do BCM2835 usado por interrupts.c
+//
+
+#include "host.h"
+
+#define IRQ_BASIC_PENDING   0x00
+#define IRQ_PENDING_1       0x04
+#define IRQ_PENDING_2       0x08
+#define IRQ_FIQ_CONTROL     0x0C
+#define IRQ_ENABLE_1        0x10
+#define IRQ_ENABLE_2        0x14
+#define IRQ_ENABLE_BASIC    0x18
+#define IRQ_DISABLE_1       0x1C
+#define IRQ_DISABLE_2       0x20
+#define IRQ_DISABLE_BASIC   0x24
+
+// Bancos: linhas 0..31, 32..63 e as básicas do ARM (64..71)
+static uint32_t pending[3];
+static uint32_t enabled[3];
+
+uint32_t host_irq_read(uint32_t offset) {
+    switch (offset) {
+        // Como no hardware, os pendings só mostram linhas habilitadas
+        case IRQ_BASIC_PENDING: return pending[2] & enabled[2] & 0xFF;
+        case IRQ_PENDING_1:     return pending[0] & enabled[0];
+        case IRQ_PENDING_2:     return pending[1] & enabled[1];
+        case IRQ_ENABLE_1:      return enabled[0];
+        case IRQ_ENABLE_2:      return enabled[1];
+        case IRQ_ENABLE_BASIC:  return enabled[2];
+        default:                return 0;
+    }
+}
+
+// Enable e disable: escrever 1 liga ou desliga só aquele bit
+void host_irq_write(uint32_t offset, uint32_t value) {
+    switch (offset) {
+        case IRQ_ENABLE_1:      enabled[0] |= value; break;
+        case IRQ_ENABLE_2:      enabled[1] |= value; break;
+        case IRQ_ENABLE_BASIC:  enabled[2] |= value & 0xFF; break;
+        case IRQ_DISABLE_1:     enabled[0] &= ~value; break;
+        case IRQ_DISABLE_2:     enabled[1] &= ~value; break;
+        case IRQ_DISABLE_BASIC: enabled[2] &= ~value; break;
+        case IRQ_FIQ_CONTROL:   break;
+    }
+}
+
+void host_irq_raise(unsigned irq) {
+    pending[irq / 32] |= 1u << (irq % 32);
+}
+
+void host_irq_clear(unsigned irq) {
+    pending[irq / 32] &= ~(1u << (irq % 32));
+}
+
+void host_irq_enable(unsigned irq) {
+    enabled[irq / 32] |= 1u << (irq % 32);
+}
+
+bool host_irq_enabled(unsigned irq) {
+    return (enabled[irq / 32] >> (irq % 32)) & 1;
+}
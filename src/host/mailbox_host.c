@@ -0,0 +1,92 @@
+//
+// mailbox_host.c - VideoCore simulado para o build host
+// Responde às tags de framebuffer com um buffer em memória
+//
+
+#include "config.h"
+#include "mailbox.h"
+#include "host.h"
+
+// Endereço de barramento fictício do framebuffer simulado
+#define HOST_BUS_BASE   0xC0000000
+
+static uint16_t vram[SCREEN_WIDTH * SCREEN_HEIGHT * 2];
+static uint32_t fb_width = 0;
+static uint32_t fb_virtual_height = 0;
+static uint32_t fb_offset_y = 0;
+static unsigned vsync_count = 0;
+static uint32_t virtual_height_limit = SCREEN_HEIGHT * 2;
+
+bool mailbox_call(uint32_t channel, volatile uint32_t *buffer) {
+    if (channel != MAILBOX_CHANNEL_PROPERTY || buffer[1] != MAILBOX_REQUEST) {
+        return false;
+    }
+    
+    uint32_t words = buffer[0] / sizeof(uint32_t);
+    uint32_t i = 2;
+    while (i < words && buffer[i] != TAG_END) {
+        uint32_t tag = buffer[i];
+        uint32_t size = buffer[i + 1];
+        volatile uint32_t *value = &buffer[i + 3];
+        
+        switch (tag) {
+            case TAG_SET_PHYSICAL_SIZE:
+                fb_width = value[0];
+                break;
+            case TAG_SET_VIRTUAL_SIZE:
+                // A memória simulada comporta no máximo duas páginas
+                if (value[1] > virtual_height_limit) {
+                    value[1] = virtual_height_limit;
+                }
+                fb_virtual_height = value[1];
+                break;
+            case TAG_SET_VIRTUAL_OFFSET:
+                if (value[1] + SCREEN_HEIGHT > fb_virtual_height) {
+                    return false;
+                }
+                fb_offset_y = value[1];
+                break;
+            case TAG_SET_DEPTH:
+                value[0] = 16;
+                break;
+            case TAG_ALLOCATE_BUFFER:
+                value[0] = HOST_BUS_BASE;
+                value[1] = sizeof(vram);
+                break;
+            case TAG_GET_PITCH:
+                value[0] = fb_width * sizeof(uint16_t);
+                break;
+            case TAG_WAIT_FOR_VSYNC:
+                vsync_count++;
+                break;
+            default:
+                return false;
+        }
+        
+        buffer[i + 2] = 0x80000000 | size;  // Resposta com o tamanho do valor
+        i += 3 + size / sizeof(uint32_t);
+    }
+    
+    buffer[1] = MAILBOX_RESPONSE_OK;
+    return true;
+}
+
+void *mailbox_bus_to_arm(uint32_t bus_address) {
+    return (uint8_t*)vram + (bus_address - HOST_BUS_BASE);
+}
+
+uint16_t *host_display_page(void) {
+    return vram + fb_offset_y * fb_width;
+}
+
+uint32_t host_display_offset(void) {
+    return fb_offset_y;
+}
+
+unsigned host_vsync_count(void) {
+    return vsync_count;
+}
+
+void host_set_virtual_height_limit(uint32_t height) {
+    virtual_height_limit = height < SCREEN_HEIGHT * 2 ? height : SCREEN_HEIGHT * 2;
+}
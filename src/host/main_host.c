@@ -0,0 +1,265 @@
+//
+// main_host.c - Execução headless do jogo no host (simulação e profiling)
+//
+// Uso: snake_host [-t ticks] [-s seed] [-r] [-c us] [-o saida.ppm] [-w gravação] [-R gravação]
+//   -t  número de ticks de simulação (padrão 100000)
+//   -s  semente do gerador aleatório (padrão 1)
+//   -r  renderizar os frames no framebuffer em memória
+//   -c  custo simulado de cada frame em microssegundos (implica -r)
+//   -o  salvar a página exibida ao final (PPM, implica -r)
+//   -w  gravar as teclas da partida em arquivo
+//   -R  reproduzir uma gravação na velocidade máxima, sem renderização
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "game.h"
+#include "graphics.h"
+#include "platform.h"
+#include "profile.h"
+#include "render.h"
+#include "replay.h"
+#include "timing.h"
+#include "host.h"
+
+static Game game;
+
+// Gerador da política (separado do gerador do jogo)
+static uint32_t policy_state = 1;
+
+static uint32_t policy_random(void) {
+    policy_state = policy_state * 1664525 + 1013904223;
+    return policy_state >> 8;
+}
+
+// Política simples: segue a comida, com curvas aleatórias ocasionais
+static unsigned char choose_key(void) {
+    Position head = game.snake.body[game.snake.head];
+    
+    if (policy_random() % 8 == 0) {
+        static const unsigned char turns[] = {KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1};
+        return turns[policy_random() % 4];
+    }
+    if (game.food.x > head.x) return KEY_RIGHT_1;
+    if (game.food.x < head.x) return KEY_LEFT_1;
+    if (game.food.y > head.y) return KEY_DOWN_1;
+    return KEY_UP_1;
+}
+
+// Checksum FNV-1a do estado final, para comparar gravação e reprodução
+static uint32_t state_checksum(const Game *g) {
+    uint32_t hash = 2166136261u;
+    uint32_t values[] = {
+        (uint32_t)g->score, (uint32_t)g->state, g->steps,
+        (uint32_t)g->snake.length, (uint32_t)g->food.x, (uint32_t)g->food.y
+    };
+    
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        hash = (hash ^ values[i]) * 16777619u;
+    }
+    for (int i = 0; i < g->snake.length; i++) {
+        Position p = snake_segment(&g->snake, i);
+        hash = (hash ^ (uint32_t)(p.y * GAME_WIDTH + p.x)) * 16777619u;
+    }
+    return hash;
+}
+
+static int run_replay(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    
+    uint8_t *data = malloc(size > 0 ? size : 1);
+    if (!data || fread(data, 1, size, f) != (size_t)size) {
+        fprintf(stderr, "%s: falha na leitura\n", path);
+        fclose(f);
+        free(data);
+        return 1;
+    }
+    fclose(f);
+    
+    ReplayPlayer player;
+    if (!replay_player_init(&player, data, size)) {
+        fprintf(stderr, "%s: gravação inválida\n", path);
+        free(data);
+        return 1;
+    }
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    uint32_t steps = replay_run(&player, &game);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    printf("replay: %ld bytes  passos: %u  score: %d\n", size, steps, game.score);
+    printf("tempo: %.3f s  (%.0f passos/s)\n", elapsed, elapsed > 0 ? steps / elapsed : 0.0);
+    printf("checksum: %08x\n", state_checksum(&game));
+    free(data);
+    return 0;
+}
+
+static void write_ppm(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return;
+    }
+    
+    const uint16_t *page = host_display_page();
+    fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+        uint16_t p = page[i];
+        unsigned char rgb[3] = {
+            (unsigned char)(((p >> 11) & 0x1F) << 3),
+            (unsigned char)(((p >> 5) & 0x3F) << 2),
+            (unsigned char)((p & 0x1F) << 3),
+        };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+int main(int argc, char **argv) {
+    unsigned long ticks = 100000;
+    unsigned int seed = 1;
+    bool render = false;
+    uint64_t render_cost_us = 0;
+    const char *ppm_path = NULL;
+    const char *record_path = NULL;
+    const char *replay_path = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            ticks = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            seed = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-r")) {
+            render = true;
+        } else if (!strcmp(argv[i], "-c") && i + 1 < argc) {
+            render_cost_us = strtoull(argv[++i], NULL, 0);
+            render = true;
+        } else if (!strcmp(argv[i], "-o") && i + 1 < argc) {
+            ppm_path = argv[++i];
+            render = true;
+        } else if (!strcmp(argv[i], "-w") && i + 1 < argc) {
+            record_path = argv[++i];
+        } else if (!strcmp(argv[i], "-R") && i + 1 < argc) {
+            replay_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [-t ticks] [-s seed] [-r] [-c us] [-o saida.ppm] "
+                            "[-w gravação] [-R gravação]\n", argv[0]);
+            return 2;
+        }
+    }
+    
+    if (replay_path) {
+        return run_replay(replay_path);
+    }
+    
+    init_graphics();
+    profile_init();
+    game_seed(&game, seed);
+    policy_state = seed;
+    init_game(&game);
+    platform_input_init();
+    
+    // Cada tick gera no máximo uma tecla de poucos bytes
+    ReplayRecorder recorder;
+    uint8_t *record_buffer = NULL;
+    if (record_path) {
+        size_t capacity = REPLAY_HEADER_SIZE + (ticks + 1) * 5;
+        record_buffer = malloc(capacity);
+        if (!record_buffer) {
+            fprintf(stderr, "sem memória para a gravação\n");
+            return 1;
+        }
+        replay_recorder_init(&recorder, record_buffer, capacity, seed);
+        game.recorder = &recorder;
+    }
+    
+    unsigned long games = 1;
+    int best_score = 0;
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    // Mesmo laço de passo fixo do Pi, sobre o relógio simulado
+    FrameClock clock;
+    frame_clock_init(&clock, get_time_us(), (uint64_t)GAME_SPEED_MS * 1000, FRAME_INTERVAL_US);
+    uint64_t sim_start = get_time_us();
+    unsigned long t = 0;
+    unsigned long frames = 0;
+    
+    while (t < ticks) {
+        uint64_t now = get_time_us();
+        
+        for (uint32_t steps = frame_clock_steps(&clock, now); steps > 0 && t < ticks; steps--, t++) {
+            if (game.state == GAME_OVER) {
+                if (game.score > best_score) {
+                    best_score = game.score;
+                }
+                host_push_key(KEY_RESTART_1);
+                games++;
+            } else {
+                host_push_key(choose_key());
+            }
+            
+            platform_poll_input(&game);
+            profile_begin(PROFILE_UPDATE);
+            game_step(&game);
+            profile_end(PROFILE_UPDATE);
+        }
+        
+        if (frame_clock_render_due(&clock, now) && render) {
+            profile_frame_mark();
+            profile_begin(PROFILE_DRAW);
+            draw_game(&game);
+            profile_end(PROFILE_DRAW);
+            host_advance_us(render_cost_us);
+            frames++;
+        }
+        
+        sleep_until_us(frame_clock_next_deadline(&clock));
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    if (game.score > best_score) {
+        best_score = game.score;
+    }
+    
+    printf("ticks: %lu  jogos: %lu  melhor score: %d\n", ticks, games, best_score);
+    printf("tempo: %.3f s  (%.0f ticks/s)\n", elapsed, elapsed > 0 ? ticks / elapsed : 0.0);
+    printf("tempo simulado: %.1f s  frames: %lu  passos descartados: %u\n",
+           (get_time_us() - sim_start) / 1e6, frames, clock.dropped_steps);
+    if (render) {
+        profile_report();
+    }
+    
+    if (record_path) {
+        replay_record_end(&recorder, game.steps);
+        FILE *f = fopen(record_path, "wb");
+        if (!f || fwrite(record_buffer, 1, recorder.size, f) != recorder.size) {
+            perror(record_path);
+        } else {
+            printf("gravação: %zu bytes  passos: %u  checksum: %08x\n",
+                   recorder.size, game.steps, state_checksum(&game));
+        }
+        if (f) {
+            fclose(f);
+        }
+        free(record_buffer);
+    }
+    
+    if (ppm_path) {
+        write_ppm(ppm_path);
+    }
+    return 0;
+}
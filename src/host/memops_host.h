@@ -0,0 +1,14 @@
+#ifndef MEMOPS_HOST_H
+#define MEMOPS_HOST_H
+
+#include <stddef.h>
+
+// memops.c no host: compilado com os símbolos renomeados (veja o Makefile)
+// para conviver com a libc, que serve de referência
+
+void *memops_memcpy(void *dest, const void *src, size_t n);
+void *memops_memmove(void *dest, const void *src, size_t n);
+void *memops_memset(void *s, int c, size_t n);
+int memops_memcmp(const void *s1, const void *s2, size_t n);
+
+#endif // MEMOPS_HOST_H
@@ -0,0 +1,70 @@
+//
+// platform_host.c - Camada de plataforma para o build host (headless)
+//
+
+#include "game.h"
+#include "input.h"
+#include "platform.h"
+#include "host.h"
+
+// Relógio simulado em microssegundos
+static uint64_t host_time_us = 0;
+
+// Mesma fila de eventos do Pi, alimentada por relatórios HID sintéticos
+static InputQueue input;
+
+uint64_t get_time_us(void) {
+    return host_time_us;
+}
+
+// Tempo simulado: "dormir" é apenas saltar o relógio até o prazo
+void sleep_until_us(uint64_t deadline) {
+    if (deadline > host_time_us) {
+        host_time_us = deadline;
+    }
+}
+
+uint32_t get_ticks(void) {
+    return (uint32_t)(host_time_us / 1000);
+}
+
+void delay_ms(unsigned int ms) {
+    host_time_us += (uint64_t)ms * 1000;
+}
+
+void host_set_ticks(uint32_t ticks) {
+    host_time_us = (uint64_t)ticks * 1000;
+}
+
+void host_advance_ticks(uint32_t ms) {
+    host_time_us += (uint64_t)ms * 1000;
+}
+
+void host_advance_us(uint64_t us) {
+    host_time_us += us;
+}
+
+void platform_input_init(void) {
+    input_init(&input);
+}
+
+void host_push_report(uint8_t modifiers, const uint8_t keys[INPUT_REPORT_KEYS]) {
+    input_report(&input, modifiers, keys, host_time_us);
+}
+
+// Toque completo: relatório com a tecla e relatório vazio em seguida
+void host_push_key(unsigned char key) {
+    uint8_t keys[INPUT_REPORT_KEYS] = { key };
+    host_push_report(0, keys);
+    keys[0] = 0;
+    host_push_report(0, keys);
+}
+
+void platform_poll_input(Game *game) {
+    InputEvent event;
+    while (input_next_event(&input, &event)) {
+        if (event.pressed) {
+            handle_input(game, event.key);
+        }
+    }
+}
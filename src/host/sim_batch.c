@@ -0,0 +1,273 @@
+//
+// sim_batch.c - Simulador em lote: muitos jogos independentes em paralelo
+//
+// Uso: snake_sim [-g jogos] [-j threads] [-p random|greedy|cycle] [-m max_ticks] [-s seed]
+//   -g  número total de jogos (padrão 10000)
+//   -j  threads do pool (padrão: núcleos disponíveis)
+//   -p  política de entrada (padrão greedy)
+//   -m  limite de ticks por jogo (padrão 100000)
+//   -s  semente base; o jogo i usa uma semente derivada de (seed, i)
+//
+// O resultado não depende do número de threads: cada jogo tem sua
+// própria semente e seu próprio gerador.
+//
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "game.h"
+
+typedef enum {
+    POLICY_RANDOM = 0,
+    POLICY_GREEDY,
+    POLICY_CYCLE
+} Policy;
+
+typedef struct {
+    pthread_t thread;
+    Game *arena;                // Jogo reutilizado, alocado pela própria thread
+    uint64_t ticks;
+    unsigned long games;
+    unsigned long board_full;
+    double score_sum;
+    double score_sq_sum;
+    int score_min;
+    int score_max;
+} Worker;
+
+static Policy policy = POLICY_GREEDY;
+static unsigned long total_games = 10000;
+static unsigned long max_ticks = 100000;
+static uint32_t base_seed = 1;
+static atomic_ulong next_game;
+
+static const unsigned char direction_keys[] = {KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1};
+static const Direction opposite[] = {DIR_DOWN, DIR_UP, DIR_RIGHT, DIR_LEFT};
+
+static uint32_t policy_random(uint32_t *state) {
+    *state = *state * 1664525 + 1013904223;
+    return *state >> 8;
+}
+
+static Position step_position(Position pos, Direction dir) {
+    switch (dir) {
+        case DIR_UP:    pos.y--; break;
+        case DIR_DOWN:  pos.y++; break;
+        case DIR_LEFT:  pos.x--; break;
+        case DIR_RIGHT: pos.x++; break;
+    }
+    return pos;
+}
+
+// Curvas aleatórias em 1 de cada 4 ticks
+static int policy_random_key(const Game *game, uint32_t *rng) {
+    (void)game;
+    if (policy_random(rng) % 4 != 0) {
+        return -1;
+    }
+    return direction_keys[policy_random(rng) % 4];
+}
+
+// Aproxima-se da comida evitando colisões imediatas
+static int policy_greedy_key(const Game *game, uint32_t *rng) {
+    Position head = game->snake.body[game->snake.head];
+    int best = -1;
+    int best_distance = 0;
+    
+    for (int d = 0; d < 4; d++) {
+        if ((Direction)d == opposite[game->snake.direction]) {
+            continue;
+        }
+        Position next = step_position(head, (Direction)d);
+        if (check_collision(game, next)) {
+            continue;
+        }
+        int distance = abs(next.x - game->food.x) + abs(next.y - game->food.y);
+        // Empates desfeitos aleatoriamente
+        if (best < 0 || distance < best_distance ||
+            (distance == best_distance && (policy_random(rng) & 1))) {
+            best = d;
+            best_distance = distance;
+        }
+    }
+    return best < 0 ? -1 : direction_keys[best];
+}
+
+// Ciclo hamiltoniano roteirizado: percorre todas as células e enche o
+// tabuleiro. Linhas em zigue-zague e uma coluna de retorno na borda;
+// requer GAME_HEIGHT par. O lado da coluna de retorno é escolhido pela
+// paridade da linha inicial para que a primeira linha siga para a direita.
+static int policy_cycle_key(const Game *game, uint32_t *rng) {
+    (void)rng;
+    Position head = game->snake.body[game->snake.head];
+    bool mirrored = ((GAME_HEIGHT / 2) % 2) == 1;
+    
+    Position p = head;
+    if (mirrored) {
+        p.x = GAME_WIDTH - 1 - p.x;
+    }
+    
+    Position n = p;
+    if (p.x == 0) {
+        if (p.y == 0) n.x = 1; else n.y--;
+    } else if (p.y % 2 == 0) {
+        if (p.x < GAME_WIDTH - 1) n.x++; else n.y++;
+    } else if (p.x > 1) {
+        n.x--;
+    } else if (p.y == GAME_HEIGHT - 1) {
+        n.x = 0;
+    } else {
+        n.y++;
+    }
+    
+    if (mirrored) {
+        n.x = GAME_WIDTH - 1 - n.x;
+    }
+    
+    if (n.x > head.x) return KEY_RIGHT_1;
+    if (n.x < head.x) return KEY_LEFT_1;
+    if (n.y > head.y) return KEY_DOWN_1;
+    return KEY_UP_1;
+}
+
+static void run_game(Worker *worker, unsigned long index) {
+    Game *game = worker->arena;
+    uint32_t seed = base_seed + (uint32_t)index * 0x9E3779B9u;
+    uint32_t rng = seed ^ 0xA5A5A5A5u;
+    
+    game_seed(game, seed);
+    init_game(game);
+    
+    unsigned long ticks = 0;
+    while (game->state == GAME_RUNNING && ticks < max_ticks) {
+        int key;
+        switch (policy) {
+            case POLICY_RANDOM: key = policy_random_key(game, &rng); break;
+            case POLICY_CYCLE:  key = policy_cycle_key(game, &rng); break;
+            default:            key = policy_greedy_key(game, &rng); break;
+        }
+        if (key >= 0) {
+            handle_input(game, (unsigned char)key);
+        }
+        game_step(game);
+        ticks++;
+    }
+    
+    worker->ticks += ticks;
+    worker->games++;
+    worker->score_sum += game->score;
+    worker->score_sq_sum += (double)game->score * game->score;
+    if (game->score < worker->score_min) worker->score_min = game->score;
+    if (game->score > worker->score_max) worker->score_max = game->score;
+    if (game->free_count == 0) worker->board_full++;
+}
+
+static void *worker_main(void *arg) {
+    Worker *worker = arg;
+    
+    // Alocado pela própria thread: memória local ao núcleo que a usa
+    worker->arena = aligned_alloc(64, (sizeof(Game) + 63) & ~(size_t)63);
+    if (!worker->arena) {
+        return NULL;
+    }
+    
+    while (true) {
+        unsigned long index = atomic_fetch_add(&next_game, 1);
+        if (index >= total_games) {
+            break;
+        }
+        run_game(worker, index);
+    }
+    
+    free(worker->arena);
+    return NULL;
+}
+
+static bool parse_policy(const char *name) {
+    if (!strcmp(name, "random")) policy = POLICY_RANDOM;
+    else if (!strcmp(name, "greedy")) policy = POLICY_GREEDY;
+    else if (!strcmp(name, "cycle")) policy = POLICY_CYCLE;
+    else return false;
+    return true;
+}
+
+int main(int argc, char **argv) {
+    long threads = sysconf(_SC_NPROCESSORS_ONLN);
+    const char *policy_name = "greedy";
+    
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-g") && i + 1 < argc) {
+            total_games = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-j") && i + 1 < argc) {
+            threads = strtol(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-p") && i + 1 < argc && parse_policy(argv[i + 1])) {
+            policy_name = argv[++i];
+        } else if (!strcmp(argv[i], "-m") && i + 1 < argc) {
+            max_ticks = strtoul(argv[++i], NULL, 0);
+        } else if (!strcmp(argv[i], "-s") && i + 1 < argc) {
+            base_seed = strtoul(argv[++i], NULL, 0);
+        } else {
+            fprintf(stderr, "uso: %s [-g jogos] [-j threads] [-p random|greedy|cycle] "
+                            "[-m max_ticks] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    
+    Worker *workers = calloc(threads, sizeof(Worker));
+    if (!workers) {
+        return 1;
+    }
+    atomic_store(&next_game, 0);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    for (long t = 0; t < threads; t++) {
+        workers[t].score_min = INT32_MAX;
+        pthread_create(&workers[t].thread, NULL, worker_main, &workers[t]);
+    }
+    
+    // Agregar estatísticas de todas as threads
+    uint64_t ticks = 0;
+    unsigned long games = 0;
+    unsigned long board_full = 0;
+    double score_sum = 0.0;
+    double score_sq_sum = 0.0;
+    int score_min = INT32_MAX;
+    int score_max = 0;
+    
+    for (long t = 0; t < threads; t++) {
+        pthread_join(workers[t].thread, NULL);
+        ticks += workers[t].ticks;
+        games += workers[t].games;
+        board_full += workers[t].board_full;
+        score_sum += workers[t].score_sum;
+        score_sq_sum += workers[t].score_sq_sum;
+        if (workers[t].games && workers[t].score_min < score_min) score_min = workers[t].score_min;
+        if (workers[t].score_max > score_max) score_max = workers[t].score_max;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    
+    double mean = games ? score_sum / games : 0.0;
+    double variance = games ? score_sq_sum / games - mean * mean : 0.0;
+    
+    printf("política: %s  threads: %ld  jogos: %lu\n", policy_name, threads, games);
+    printf("ticks: %llu  tempo: %.3f s  (%.0f ticks/s)\n",
+           (unsigned long long)ticks, elapsed, elapsed > 0 ? ticks / elapsed : 0.0);
+    printf("score: média %.1f  desvio %.1f  min %d  max %d  tabuleiro cheio: %lu\n",
+           mean, variance > 0 ? sqrt(variance) : 0.0,
+           games ? score_min : 0, score_max, board_full);
+    
+    free(workers);
+    return games == total_games ? 0 : 1;
+}
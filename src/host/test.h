@@ -0,0 +1,48 @@
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Verificações dos testes do host. Cada teste é um executável próprio:
+// as falhas são contadas e listadas com arquivo e linha, e test_result()
+// vira o status de saída (0 = tudo passou).
+
+static int test_failures = 0;
+
+#define CHECK(cond) do {                                                        \
+    if (!(cond)) {                                                              \
+        test_failures++;                                                        \
+        fprintf(stderr, "%s:%d: falhou: %s\n", __FILE__, __LINE__, #cond);     \
+    }                                                                           \
+} while (0)
+
+// Igualdade de inteiros, mostrando os dois valores na falha
+#define CHECK_EQ(actual, expected) do {                                         \
+    long long actual_ = (long long)(actual);                                    \
+    long long expected_ = (long long)(expected);                                \
+    if (actual_ != expected_) {                                                 \
+        test_failures++;                                                        \
+        fprintf(stderr, "%s:%d: falhou: %s == %s (%lld != %lld)\n",             \
+                __FILE__, __LINE__, #actual, #expected, actual_, expected_);    \
+    }                                                                           \
+} while (0)
+
+static inline int test_result(const char *name) {
+    if (test_failures) {
+        printf("%s: %d falha(s)\n", name, test_failures);
+        return 1;
+    }
+    printf("%s: ok\n", name);
+    return 0;
+}
+
+// Relógio monotônico para os benchmarks
+static inline uint64_t test_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+#endif // TEST_H
@@ -0,0 +1,173 @@
+//
+// test_aeabi_div.c - Divisões do AEABI contra os operadores nativos
+//
+// Casos de borda (dividendo menor que o divisor, divisão por zero,
+// INT_MIN / -1, valores de 64 bits acima de 32) e pares aleatórios com
+// magnitudes de todos os tamanhos, conferindo quociente e resto.
+//
+
+#include <limits.h>
+#include "aeabi_host.h"
+#include "test.h"
+
+#define RANDOM_PAIRS    2000000
+
+static uint64_t random_state = 0x9E3779B97F4A7C15ull;
+
+static uint64_t random64(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+// Magnitude aleatória de 0 a 64 bits: exercita todas as distâncias de CLZ
+static uint64_t random_bits(void) {
+    unsigned bits = random64() % 65;
+    return bits ? random64() >> (64 - bits) : 0;
+}
+
+static uint32_t quotient_of(uint64_t packed) {
+    return (uint32_t)packed;
+}
+
+static uint32_t remainder_of(uint64_t packed) {
+    return (uint32_t)(packed >> 32);
+}
+
+static void check_u32(uint32_t n, uint32_t d) {
+    uint64_t packed = __aeabi_uidivmod(n, d);
+    uint32_t q = d ? n / d : 0;
+    uint32_t r = d ? n % d : n;
+    
+    CHECK_EQ(__aeabi_uidiv(n, d), q);
+    CHECK_EQ(quotient_of(packed), q);
+    CHECK_EQ(remainder_of(packed), r);
+}
+
+static void check_s32(int32_t n, int32_t d) {
+    int32_t q;
+    int32_t r;
+    if (d == 0) {
+        q = 0;
+        r = n;
+    } else if (n == INT_MIN && d == -1) {
+        q = INT_MIN;            // Como o SDIV: sem trap
+        r = 0;
+    } else {
+        q = n / d;
+        r = n % d;
+    }
+    
+    uint64_t packed = __aeabi_idivmod(n, d);
+    CHECK_EQ(__aeabi_idiv(n, d), q);
+    CHECK_EQ((int32_t)quotient_of(packed), q);
+    CHECK_EQ((int32_t)remainder_of(packed), r);
+}
+
+static void check_u64(uint64_t n, uint64_t d) {
+    uint64_t r;
+    uint64_t q = aeabi_uldivmod_c(n, d, &r);
+    CHECK(q == (d ? n / d : 0));
+    CHECK(r == (d ? n % d : n));
+}
+
+static void check_s64(int64_t n, int64_t d) {
+    int64_t q_expected;
+    int64_t r_expected;
+    if (d == 0) {
+        q_expected = 0;
+        r_expected = n;
+    } else if (n == LLONG_MIN && d == -1) {
+        q_expected = LLONG_MIN;
+        r_expected = 0;
+    } else {
+        q_expected = n / d;
+        r_expected = n % d;
+    }
+    
+    int64_t r;
+    int64_t q = aeabi_ldivmod_c(n, d, &r);
+    CHECK_EQ(q, q_expected);
+    CHECK_EQ(r, r_expected);
+}
+
+static void test_edge_cases(void) {
+    // Dividendo menor que o divisor
+    check_u32(3, 7);
+    check_u32(0, 1);
+    check_u32(0xFFFFFFFE, 0xFFFFFFFF);
+    check_s32(-3, 7);
+    check_s32(3, -7);
+    
+    // Divisão por zero: quociente 0, resto = dividendo
+    check_u32(12345, 0);
+    check_u32(0, 0);
+    check_s32(-12345, 0);
+    check_u64(0x123456789ABCull, 0);
+    check_s64(-0x123456789ABCll, 0);
+    CHECK_EQ(__aeabi_uidiv(0xFFFFFFFF, 0), 0);
+    CHECK_EQ(__aeabi_idiv(INT_MIN, 0), 0);
+    
+    // INT_MIN: magnitude que não cabe em int
+    check_s32(INT_MIN, -1);
+    check_s32(INT_MIN, 1);
+    check_s32(INT_MIN, INT_MIN);
+    check_s32(INT_MIN, INT_MAX);
+    check_s32(INT_MAX, INT_MIN);
+    check_s32(INT_MIN, 2);
+    check_s32(INT_MIN, -3);
+    check_s64(LLONG_MIN, -1);
+    check_s64(LLONG_MIN, 1);
+    check_s64(LLONG_MIN, LLONG_MIN);
+    check_s64(LLONG_MAX, LLONG_MIN);
+    check_s64(LLONG_MIN, 7);
+    
+    // Quocientes e restos extremos
+    check_u32(0xFFFFFFFF, 1);
+    check_u32(0xFFFFFFFF, 2);
+    check_u32(0x80000000, 0x80000000);
+    check_u32(0xFFFFFFFF, 0x80000001);
+    
+    // 64 bits acima de 32: dividendo, divisor ou os dois
+    check_u64(0x100000000ull, 1);
+    check_u64(0x100000000ull, 0xFFFFFFFF);
+    check_u64(UINT64_MAX, 1);
+    check_u64(UINT64_MAX, 0xFFFFFFFFull);
+    check_u64(UINT64_MAX, 0x100000000ull);
+    check_u64(UINT64_MAX, UINT64_MAX);
+    check_u64(UINT64_MAX - 1, UINT64_MAX);
+    check_u64(0xFFFFFFFFull, 0x100000000ull);
+    check_u64(0x8000000000000000ull, 3);
+    check_u64(1000000000000ull, 1000000);
+    check_s64(-1000000000000ll, 1000000);
+    check_s64(1000000000000ll, -0x100000001ll);
+}
+
+static void test_random_pairs(void) {
+    for (int i = 0; i < RANDOM_PAIRS; i++) {
+        uint64_t n = random_bits();
+        uint64_t d = random_bits();
+        
+        check_u32((uint32_t)n, (uint32_t)d);
+        check_s32((int32_t)n, (int32_t)d);
+        check_u64(n, d);
+        check_s64((int64_t)n, (int64_t)d);
+        
+        // Sinais trocados com as mesmas magnitudes
+        check_s32(-(int32_t)(n >> 33), (int32_t)(d >> 32));
+        check_s64(-(int64_t)(n >> 1), -(int64_t)(d >> 1) - 1);
+        
+        if (test_failures) {
+            fprintf(stderr, "par %d: %llx / %llx\n", i,
+                    (unsigned long long)n, (unsigned long long)d);
+            return;
+        }
+    }
+}
+
+int main(void) {
+    test_edge_cases();
+    test_random_pairs();
+    return test_result("test_aeabi_div");
+}
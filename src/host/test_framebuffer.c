@@ -0,0 +1,85 @@
+//
+// test_framebuffer.c - Alocação pelo mailbox e troca de páginas
+//
+// Roda graphics.c sobre o VideoCore simulado (mailbox_host.c): páginas
+// alocadas, offset virtual a cada swap, vsync e a página única quando a
+// GPU recusa a altura dupla.
+//
+
+#include "graphics.h"
+#include "host.h"
+#include "test.h"
+
+#define PAGE_PIXELS (SCREEN_WIDTH * SCREEN_HEIGHT)
+
+static bool page_is(const uint16_t *page, uint16_t color) {
+    for (int i = 0; i < PAGE_PIXELS; i++) {
+        if (page[i] != color) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void test_double_buffer(void) {
+    init_graphics();
+    CHECK_EQ(graphics_page_count(), 2);
+    CHECK_EQ(host_display_offset(), 0);
+    
+    // Desenho vai para a página escondida, logo abaixo da exibida
+    uint16_t *front = host_display_page();
+    CHECK(framebuffer == front + PAGE_PIXELS);
+    CHECK(page_is(front, BACKGROUND_COLOR));
+    CHECK(page_is(framebuffer, BACKGROUND_COLOR));
+    
+    graphics_draw_rect(100, 50, 20, 10, COLOR_RED);
+    CHECK_EQ(front[50 * SCREEN_WIDTH + 100], BACKGROUND_COLOR);
+    
+    graphics_set_vsync(true);
+    unsigned vsyncs = host_vsync_count();
+    graphics_swap_buffers();
+    CHECK_EQ(host_display_offset(), SCREEN_HEIGHT);
+    CHECK_EQ(host_vsync_count(), vsyncs + 1);
+    CHECK_EQ(host_display_page()[50 * SCREEN_WIDTH + 100], COLOR_RED);
+    CHECK_EQ(host_display_page()[60 * SCREEN_WIDTH + 100], BACKGROUND_COLOR);
+    
+    // A antiga página da frente vira a de trás
+    CHECK(framebuffer == front);
+    
+    // Sem vsync o offset continua alternando, sem esperar
+    graphics_set_vsync(false);
+    for (int i = 0; i < 10; i++) {
+        uint32_t before = host_display_offset();
+        uint16_t *back = framebuffer;
+        graphics_swap_buffers();
+        CHECK_EQ(host_display_offset(), before ? 0 : SCREEN_HEIGHT);
+        CHECK(host_display_page() == back);
+        CHECK(framebuffer != back);
+    }
+    CHECK_EQ(host_vsync_count(), vsyncs + 1);
+    graphics_set_vsync(GRAPHICS_VSYNC);
+}
+
+static void test_single_page_fallback(void) {
+    host_set_virtual_height_limit(SCREEN_HEIGHT);
+    init_graphics();
+    CHECK_EQ(graphics_page_count(), 1);
+    CHECK(framebuffer == host_display_page());
+    
+    // Com uma página o swap não fala com a GPU
+    unsigned vsyncs = host_vsync_count();
+    graphics_draw_rect(0, 0, 8, 8, COLOR_BLUE);
+    graphics_swap_buffers();
+    CHECK_EQ(host_display_offset(), 0);
+    CHECK_EQ(host_vsync_count(), vsyncs);
+    CHECK(framebuffer == host_display_page());
+    CHECK_EQ(host_display_page()[0], COLOR_BLUE);
+    
+    host_set_virtual_height_limit(SCREEN_HEIGHT * 2);
+}
+
+int main(void) {
+    test_double_buffer();
+    test_single_page_fallback();
+    return test_result("test_framebuffer");
+}
@@ -0,0 +1,324 @@
+//
+// test_game.c - Estruturas incrementais do núcleo do jogo
+//
+// O buffer circular tem de andar junto, passo a passo, com a cobra antiga
+// que deslocava o vetor inteiro. O mapa de ocupação tem de concordar, a
+// cada passo, com uma busca linear nos segmentos da cobra (ocupação e
+// colisão), e o conjunto de células livres tem de pôr a comida na única
+// célula que resta até o tabuleiro encher.
+//
+
+#include "game.h"
+#include "test.h"
+
+#define RANDOM_STEPS    200000
+
+static Game game;
+
+static uint32_t script_state = 99;
+
+static uint32_t script_random(void) {
+    script_state = script_state * 1664525 + 1013904223;
+    return script_state >> 8;
+}
+
+// Referências pela busca linear nos segmentos
+static bool scan_occupies(const Snake *snake, Position pos) {
+    for (int i = 0; i < snake->length; i++) {
+        Position p = snake_segment(snake, i);
+        if (p.x == pos.x && p.y == pos.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool scan_collision(const Snake *snake, Position pos) {
+    if (pos.x < 0 || pos.x >= GAME_WIDTH || pos.y < 0 || pos.y >= GAME_HEIGHT) {
+        return true;
+    }
+    for (int i = 1; i < snake->length; i++) {
+        Position p = snake_segment(snake, i);
+        if (p.x == pos.x && p.y == pos.y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool occupancy_matches_scan(void) {
+    for (int y = -1; y <= GAME_HEIGHT; y++) {
+        for (int x = -1; x <= GAME_WIDTH; x++) {
+            Position pos = {x, y};
+            bool inside = x >= 0 && x < GAME_WIDTH && y >= 0 && y < GAME_HEIGHT;
+            if (inside && snake_occupies(&game.snake, pos) != scan_occupies(&game.snake, pos)) {
+                fprintf(stderr, "ocupação difere em (%d, %d)\n", x, y);
+                return false;
+            }
+            if (check_collision(&game, pos) != scan_collision(&game.snake, pos)) {
+                fprintf(stderr, "colisão difere em (%d, %d)\n", x, y);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Vizinha da cabeça numa direção
+static Position step_from(Position pos, Direction dir) {
+    switch (dir) {
+        case DIR_UP:    pos.y--; break;
+        case DIR_DOWN:  pos.y++; break;
+        case DIR_LEFT:  pos.x--; break;
+        case DIR_RIGHT: pos.x++; break;
+    }
+    return pos;
+}
+
+// Segue a comida evitando colisões (pela referência linear), com desvios
+// aleatórios: a cobra cresce e o corpo dá voltas pelo buffer circular
+static void steer(void) {
+    static const unsigned char keys[] = {KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1};
+    Position head = game.snake.body[game.snake.head];
+    Direction order[4];
+    int n = 0;
+    
+    if (script_random() % 8 == 0) {
+        order[n++] = (Direction)(script_random() % 4);
+    }
+    if (game.food.x != head.x) order[n++] = game.food.x > head.x ? DIR_RIGHT : DIR_LEFT;
+    if (game.food.y != head.y) order[n++] = game.food.y > head.y ? DIR_DOWN : DIR_UP;
+    order[n++] = game.snake.direction;
+    
+    for (int i = 0; i < n; i++) {
+        if (!scan_collision(&game.snake, step_from(head, order[i]))) {
+            handle_input(&game, keys[order[i]]);
+            return;
+        }
+    }
+    for (int dir = 0; dir < 4; dir++) {
+        if (!scan_collision(&game.snake, step_from(head, (Direction)dir))) {
+            handle_input(&game, keys[dir]);
+            return;
+        }
+    }
+}
+
+// Cobra de referência como era antes do buffer circular: body[0] é a
+// cabeça e cada passo desloca o vetor inteiro. Ao crescer a cauda antiga
+// fica no lugar (a versão antiga expunha uma posição velha do vetor).
+typedef struct {
+    Position body[MAX_SNAKE_LENGTH];
+    int length;
+    int score;
+    bool over;
+} ShiftSnake;
+
+static ShiftSnake shift;
+
+static void shift_reset(void) {
+    shift.length = game.snake.length;
+    for (int i = 0; i < shift.length; i++) {
+        shift.body[i] = snake_segment(&game.snake, i);
+    }
+    shift.score = game.score;
+    shift.over = false;
+}
+
+// Um passo na direção que o jogo aplicou, com a comida de antes do passo
+static void shift_step(Direction dir, Position food) {
+    Position new_head = step_from(shift.body[0], dir);
+    
+    if (new_head.x < 0 || new_head.x >= GAME_WIDTH || new_head.y < 0 || new_head.y >= GAME_HEIGHT) {
+        shift.over = true;
+        return;
+    }
+    for (int i = 1; i < shift.length; i++) {
+        if (shift.body[i].x == new_head.x && shift.body[i].y == new_head.y) {
+            shift.over = true;
+            return;
+        }
+    }
+    
+    bool grows = new_head.x == food.x && new_head.y == food.y && shift.length < MAX_SNAKE_LENGTH;
+    if (grows) {
+        shift.length++;
+    }
+    for (int i = shift.length - 1; i > 0; i--) {
+        shift.body[i] = shift.body[i - 1];
+    }
+    shift.body[0] = new_head;
+    if (new_head.x == food.x && new_head.y == food.y) {
+        shift.score += POINTS_PER_FOOD;
+    }
+}
+
+static bool ring_matches_shift(void) {
+    if ((game.state == GAME_OVER) != shift.over || game.snake.length != shift.length ||
+        game.score != shift.score) {
+        fprintf(stderr, "estado: fim %d/%d, comprimento %d/%d, pontos %d/%d\n",
+                game.state == GAME_OVER, shift.over, game.snake.length, shift.length,
+                game.score, shift.score);
+        return false;
+    }
+    for (int i = 0; i < shift.length; i++) {
+        Position p = snake_segment(&game.snake, i);
+        if (p.x != shift.body[i].x || p.y != shift.body[i].y) {
+            fprintf(stderr, "segmento %d: (%d, %d), esperado (%d, %d)\n",
+                    i, p.x, p.y, shift.body[i].x, shift.body[i].y);
+            return false;
+        }
+    }
+    return true;
+}
+
+// Entrada aleatória em partidas longas: o índice da cabeça dá várias
+// voltas no buffer e as partidas terminam por colisão e recomeçam
+static void test_ring_matches_shift(void) {
+    game_seed(&game, 3);
+    init_game(&game);
+    shift_reset();
+    int games = 0;
+    int wraps = 0;
+    
+    for (int step = 0; step < RANDOM_STEPS; step++) {
+        if (game.state == GAME_OVER) {
+            handle_input(&game, KEY_RESTART_1);
+            shift_reset();
+            games++;
+        }
+        
+        // Sem desviar das colisões em parte dos passos, para terminar partidas
+        if (script_random() % 64 != 0) {
+            steer();
+        }
+        Position food = game.food;
+        int head = game.snake.head;
+        game_step(&game);
+        if (game.snake.head > head) {
+            wraps++;
+        }
+        shift_step(game.snake.direction, food);
+        
+        if (!ring_matches_shift()) {
+            fprintf(stderr, "passo %d, partida %d\n", step, games);
+            test_failures++;
+            return;
+        }
+    }
+    
+    CHECK(games > 10);
+    CHECK(wraps > 10);
+}
+
+static void test_occupancy_matches_scan(void) {
+    game_seed(&game, 5);
+    init_game(&game);
+    int longest = 0;
+    
+    for (int step = 0; step < RANDOM_STEPS; step++) {
+        if (game.state == GAME_OVER) {
+            handle_input(&game, KEY_RESTART_1);
+        }
+        steer();
+        game_step(&game);
+        if (game.snake.length > longest) {
+            longest = game.snake.length;
+        }
+        
+        // A verificação completa é cara: a cada passo no início, depois espaçada
+        if ((step < 2000 || step % 97 == 0) && !occupancy_matches_scan()) {
+            fprintf(stderr, "passo %d, comprimento %d\n", step, game.snake.length);
+            test_failures++;
+            return;
+        }
+    }
+    
+    // A política tem de ter feito a cobra crescer de fato
+    CHECK(longest > 50);
+}
+
+// Ciclo hamiltoniano sobre o tabuleiro (largura par): linhas ímpares para
+// a direita, pares para a esquerda a partir de x = 1, subindo pela borda
+// direita e voltando pela coluna 0. A cobra inicial está na linha 15
+// indo para a direita, já dentro do ciclo.
+static Direction cycle_direction(Position head) {
+    if (head.x == 0) {
+        return head.y == GAME_HEIGHT - 1 ? DIR_RIGHT : DIR_DOWN;
+    }
+    if (head.y % 2 == 1) {
+        return head.x < GAME_WIDTH - 1 ? DIR_RIGHT : DIR_UP;
+    }
+    if (head.x > 1) {
+        return DIR_LEFT;
+    }
+    return head.y == 0 ? DIR_LEFT : DIR_UP;
+}
+
+// Célula livre por busca linear (-1 se não houver)
+static int scan_free_cell(void) {
+    for (int cell = 0; cell < GRID_CELLS; cell++) {
+        Position pos = {cell % GAME_WIDTH, cell / GAME_WIDTH};
+        if (!scan_occupies(&game.snake, pos)) {
+            return cell;
+        }
+    }
+    return -1;
+}
+
+static void test_fill_board(void) {
+    static const unsigned char keys[] = {KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1};
+    bool saw_last_cell = false;
+    
+    game_seed(&game, 11);
+    init_game(&game);
+    
+    // Seguindo o ciclo a cobra nunca colide e come toda comida
+    while (game.state == GAME_RUNNING) {
+        CHECK_EQ(game.free_count + game.snake.length, GRID_CELLS);
+        CHECK(!scan_occupies(&game.snake, game.food));
+        
+        if (game.snake.length == GRID_CELLS - 1 && !saw_last_cell) {
+            // N - 1 células: a comida só pode estar na que sobrou
+            int cell = scan_free_cell();
+            CHECK_EQ(game.free_count, 1);
+            CHECK_EQ(game.free_cells[0], cell);
+            CHECK_EQ(game.food.y * GAME_WIDTH + game.food.x, cell);
+            saw_last_cell = true;
+        }
+        
+        Direction dir = cycle_direction(game.snake.body[game.snake.head]);
+        if (dir != game.snake.direction) {
+            handle_input(&game, keys[dir]);
+        }
+        game_step(&game);
+        
+        if (test_failures) {
+            return;
+        }
+    }
+    
+    // N células: sem espaço para comida, fim de jogo com redesenho completo
+    CHECK(saw_last_cell);
+    CHECK_EQ(game.state, GAME_OVER);
+    CHECK_EQ(game.snake.length, GRID_CELLS);
+    CHECK_EQ(game.free_count, 0);
+    CHECK_EQ(scan_free_cell(), -1);
+    CHECK_EQ(game.food.x, -1);
+    CHECK_EQ(game.food.y, -1);
+    CHECK(game.dirty.full_redraw);
+    CHECK_EQ(game.score, (GRID_CELLS - INITIAL_SNAKE_LENGTH) * POINTS_PER_FOOD);
+    
+    // Reinício a partir do tabuleiro cheio volta ao estado inicial
+    handle_input(&game, KEY_RESTART_1);
+    CHECK_EQ(game.state, GAME_RUNNING);
+    CHECK_EQ(game.free_count, GRID_CELLS - INITIAL_SNAKE_LENGTH);
+    CHECK(!scan_occupies(&game.snake, game.food));
+}
+
+int main(void) {
+    test_ring_matches_shift();
+    test_occupancy_matches_scan();
+    test_fill_board();
+    return test_result("test_game");
+}
@@ -0,0 +1,139 @@
+//
+// test_graphics.c - Preenchimento de spans e recorte de retângulos
+//
+// graphics_fill_span() em todos os alinhamentos e comprimentos curtos
+// (cabeça, corpo largo e cauda), e graphics_draw_rect() com retângulos e
+// regiões de recorte aleatórios contra um preenchimento pixel a pixel.
+//
+
+#include <string.h>
+#include "graphics.h"
+#include "test.h"
+
+#define PAGE_PIXELS (SCREEN_WIDTH * SCREEN_HEIGHT)
+#define SPAN_MAX    200
+#define GUARD       16
+#define RECT_TRIALS 20000
+
+static uint16_t span_buffer[SPAN_MAX + 2 * GUARD] __attribute__((aligned(16)));
+static uint16_t expected[PAGE_PIXELS];
+
+static uint32_t random_state = 12345;
+
+static uint32_t test_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+// Valor entre lo e hi inclusive
+static int random_between(int lo, int hi) {
+    return lo + (int)(test_random() % (uint32_t)(hi - lo + 1));
+}
+
+static void test_fill_span(void) {
+    // Deslocamentos de 0 a 7 pixels cobrem todos os alinhamentos até 16 bytes
+    for (int offset = 0; offset < 8; offset++) {
+        for (int count = 0; count <= SPAN_MAX; count++) {
+            uint16_t color = (uint16_t)(0x1234 + count);
+            memset(span_buffer, 0xEE, sizeof(span_buffer));
+            graphics_fill_span(span_buffer + GUARD + offset, count, color);
+            
+            for (int i = 0; i < SPAN_MAX + 2 * GUARD; i++) {
+                bool inside = i >= GUARD + offset && i < GUARD + offset + count;
+                if (span_buffer[i] != (inside ? color : 0xEEEE)) {
+                    fprintf(stderr, "span offset %d count %d: índice %d = %04x\n",
+                            offset, count, i, span_buffer[i]);
+                    test_failures++;
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Contagem negativa não escreve nada
+    memset(span_buffer, 0xEE, sizeof(span_buffer));
+    graphics_fill_span(span_buffer + GUARD, -5, 0);
+    CHECK_EQ(span_buffer[GUARD], 0xEEEE);
+}
+
+// Referência: pixel a pixel, testando cada um contra tela e recorte
+static void reference_rect(int x, int y, int width, int height, uint16_t color,
+                           int cx, int cy, int cw, int ch) {
+    for (int py = y; py < y + height; py++) {
+        for (int px = x; px < x + width; px++) {
+            if (px >= 0 && px < SCREEN_WIDTH && py >= 0 && py < SCREEN_HEIGHT &&
+                px >= cx && px < cx + cw && py >= cy && py < cy + ch) {
+                expected[py * SCREEN_WIDTH + px] = color;
+            }
+        }
+    }
+}
+
+static void test_clipped_rects(void) {
+    graphics_reset_clip();
+    graphics_clear_screen(COLOR_BLACK);
+    memcpy(expected, framebuffer, sizeof(expected));
+    
+    for (int trial = 0; trial < RECT_TRIALS; trial++) {
+        // Recortes parcialmente fora da tela e vazios também
+        int cx = random_between(-40, SCREEN_WIDTH);
+        int cy = random_between(-40, SCREEN_HEIGHT);
+        int cw = random_between(0, 200);
+        int ch = random_between(0, 200);
+        int x = random_between(-60, SCREEN_WIDTH + 20);
+        int y = random_between(-60, SCREEN_HEIGHT + 20);
+        int width = random_between(-4, 120);
+        int height = random_between(-4, 120);
+        uint16_t color = (uint16_t)test_random();
+        
+        if (trial % 8 == 0) {
+            graphics_reset_clip();
+            cx = cy = 0;
+            cw = SCREEN_WIDTH;
+            ch = SCREEN_HEIGHT;
+        } else {
+            graphics_set_clip(cx, cy, cw, ch);
+        }
+        
+        graphics_draw_rect(x, y, width, height, color);
+        reference_rect(x, y, width, height, color, cx, cy, cw, ch);
+        
+        if (memcmp(framebuffer, expected, sizeof(expected)) != 0) {
+            fprintf(stderr, "retângulo %d: (%d, %d) %dx%d, recorte (%d, %d) %dx%d\n",
+                    trial, x, y, width, height, cx, cy, cw, ch);
+            test_failures++;
+            break;
+        }
+    }
+    graphics_reset_clip();
+}
+
+// O contorno são quatro retângulos: também respeita o recorte
+static void test_outline_and_pixel_clip(void) {
+    graphics_clear_screen(COLOR_BLACK);
+    graphics_set_clip(10, 10, 5, 5);
+    graphics_draw_rect_outline(11, 11, 10, 10, COLOR_WHITE);
+    draw_pixel(9, 9, COLOR_RED);
+    draw_pixel(13, 13, COLOR_RED);
+    graphics_reset_clip();
+    
+    // Bordas superior e esquerda cortadas em x/y = 14; direita e inferior
+    // (x/y = 20) inteiramente fora
+    CHECK_EQ(framebuffer[11 * SCREEN_WIDTH + 14], COLOR_WHITE);
+    CHECK_EQ(framebuffer[11 * SCREEN_WIDTH + 15], COLOR_BLACK);
+    CHECK_EQ(framebuffer[14 * SCREEN_WIDTH + 11], COLOR_WHITE);
+    CHECK_EQ(framebuffer[15 * SCREEN_WIDTH + 11], COLOR_BLACK);
+    CHECK_EQ(framebuffer[12 * SCREEN_WIDTH + 20], COLOR_BLACK);
+    CHECK_EQ(framebuffer[20 * SCREEN_WIDTH + 12], COLOR_BLACK);
+    CHECK_EQ(framebuffer[9 * SCREEN_WIDTH + 9], COLOR_BLACK);
+    CHECK_EQ(framebuffer[13 * SCREEN_WIDTH + 13], COLOR_RED);
+}
+
+int main(void) {
+    init_graphics();
+    test_fill_span();
+    test_clipped_rects();
+    test_outline_and_pixel_clip();
+    return test_result(GRAPHICS_SPAN_FILL == SPAN_FILL_SCALAR ? "test_graphics (escalar)"
+                                                              : "test_graphics");
+}
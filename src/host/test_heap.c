@@ -0,0 +1,289 @@
+//
+// test_heap.c - Estresse do alocador com alocações, realocações e liberações
+//
+// Sequência aleatória sobre um heap pequeno o bastante para encher: cada
+// bloco é preenchido com um padrão próprio e conferido ao ser realocado ou
+// liberado (blocos sobrepostos se corromperiam), heap_check() roda a cada
+// poucas operações e, liberado tudo, o uso volta a zero e a região inteira
+// volta a caber num só bloco. Parte dos blocos vem de heap_alloc_aligned(),
+// como os buffers de DMA, e cresce no lugar com heap_realloc_aligned().
+//
+
+#include <string.h>
+#include "heap.h"
+#include "test.h"
+
+#define HEAP_SIZE       (1024 * 1024)
+#define SLOTS           512
+#define OPERATIONS      200000
+#define CHECK_INTERVAL  37
+
+typedef struct {
+    uint8_t *ptr;
+    size_t size;
+    size_t align;
+    uint8_t tag;
+} Allocation;
+
+static uint8_t region[HEAP_SIZE + 64];
+static Allocation slots[SLOTS];
+
+static uint32_t random_state = 2024;
+
+static uint32_t test_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+// Tamanhos log-uniformes até 64 KiB: muitos pequenos (listas rápidas),
+// alguns grandes (classes logarítmicas e divisão de blocos)
+static size_t random_size(void) {
+    unsigned bits = test_random() % 17;
+    return test_random() & ((1u << bits) - 1);
+}
+
+static void fill(Allocation *a) {
+    for (size_t i = 0; i < a->size; i++) {
+        a->ptr[i] = (uint8_t)(a->tag + i * 7);
+    }
+}
+
+static bool intact(const Allocation *a, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (a->ptr[i] != (uint8_t)(a->tag + i * 7)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void check_block(const Allocation *a) {
+    CHECK(((uintptr_t)a->ptr & (a->align - 1)) == 0);
+    CHECK(heap_usable_size(a->ptr) >= a->size);
+}
+
+static void stress(void) {
+    MemStats stats;
+    uint32_t failures = 0;
+    
+    for (uint32_t op = 0; op < OPERATIONS; op++) {
+        Allocation *a = &slots[test_random() % SLOTS];
+        uint32_t kind = test_random() % 8;
+        
+        if (!a->ptr) {
+            size_t size = random_size();
+            // Alinhamentos de 32 B a 4 KiB (linha de cache a página)
+            a->align = kind == 1 ? (size_t)32 << (test_random() % 8) : HEAP_ALIGN;
+            if (kind == 0) {
+                a->ptr = heap_calloc(1, size);
+            } else if (kind == 1) {
+                a->ptr = heap_alloc_aligned(size, a->align);
+            } else {
+                a->ptr = heap_alloc(size);
+            }
+            if (!a->ptr) {
+                failures++;
+                continue;
+            }
+            a->size = size;
+            a->tag = (uint8_t)op;
+            check_block(a);
+            if (kind == 0) {
+                for (size_t i = 0; i < size; i++) {
+                    if (a->ptr[i]) {
+                        fprintf(stderr, "calloc: byte %zu não zerado\n", i);
+                        test_failures++;
+                        return;
+                    }
+                }
+            }
+            fill(a);
+        } else if (kind < 3) {
+            // Realoca: o prefixo comum sobrevive, cresça ou encolha o bloco
+            size_t size = random_size() + 1;
+            uint8_t *moved = heap_realloc(a->ptr, size);
+            if (!moved) {
+                failures++;
+                CHECK(intact(a, a->size));
+                continue;
+            }
+            // heap_realloc só garante o alinhamento básico
+            a->ptr = moved;
+            a->align = HEAP_ALIGN;
+            size_t kept = size < a->size ? size : a->size;
+            if (!intact(a, kept)) {
+                fprintf(stderr, "operação %u: realloc %zu -> %zu perdeu dados\n", op, a->size, size);
+                test_failures++;
+                return;
+            }
+            a->size = size;
+            check_block(a);
+            fill(a);
+        } else {
+            if (!intact(a, a->size)) {
+                fprintf(stderr, "operação %u: bloco de %zu bytes corrompido\n", op, a->size);
+                test_failures++;
+                return;
+            }
+            heap_free(a->ptr);
+            a->ptr = NULL;
+        }
+        
+        if (op % CHECK_INTERVAL == 0 && !heap_check()) {
+            fprintf(stderr, "operação %u: heap_check falhou\n", op);
+            test_failures++;
+            return;
+        }
+    }
+    
+    // O heap encheu em algum momento, e as recusas foram contadas
+    heap_get_stats(&stats);
+    CHECK(failures > 0);
+    CHECK_EQ(stats.failed, failures);
+    CHECK(stats.peak_in_use > HEAP_SIZE / 2);
+}
+
+static void free_all(void) {
+    for (int i = 0; i < SLOTS; i++) {
+        if (slots[i].ptr) {
+            CHECK(intact(&slots[i], slots[i].size));
+            heap_free(slots[i].ptr);
+            slots[i].ptr = NULL;
+        }
+    }
+    CHECK(heap_check());
+    
+    MemStats stats;
+    heap_get_stats(&stats);
+    CHECK_EQ(stats.in_use, 0);
+    CHECK_EQ(stats.allocations, 0);
+    CHECK_EQ(stats.free_bytes, stats.size);
+    
+    // Sem vazamento nem fragmentação: a região inteira num só bloco
+    // (as listas rápidas são consolidadas no caminho)
+    void *whole = heap_alloc(stats.size - 16);
+    CHECK(whole != NULL);
+    heap_free(whole);
+    CHECK(heap_check());
+}
+
+// Cada alinhamento com tamanhos em volta de múltiplos da linha; blocos
+// vizinhos não podem se sobrepor
+static void test_aligned(void) {
+    static const size_t sizes[] = { 0, 1, 31, 32, 33, 64, 100, 1000, 4096, 5000 };
+    void *blocks[sizeof(sizes) / sizeof(sizes[0])];
+    
+    for (size_t align = 32; align <= 4096; align *= 2) {
+        for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            blocks[i] = heap_alloc_aligned(sizes[i], align);
+            CHECK(blocks[i] != NULL);
+            CHECK_EQ((uintptr_t)blocks[i] & (align - 1), 0);
+            CHECK(heap_usable_size(blocks[i]) >= sizes[i]);
+            memset(blocks[i], (int)i, sizes[i]);
+        }
+        CHECK(heap_check());
+        
+        for (unsigned i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+            for (size_t j = 0; j < sizes[i]; j++) {
+                if (((uint8_t *)blocks[i])[j] != i) {
+                    fprintf(stderr, "alinhamento %zu: bloco %u corrompido\n", align, i);
+                    test_failures++;
+                    break;
+                }
+            }
+            heap_free(blocks[i]);
+        }
+        CHECK(heap_check());
+    }
+    
+    // Alinhamento básico cai em heap_alloc; grandes demais falham
+    void *p = heap_alloc_aligned(10, HEAP_ALIGN);
+    CHECK(p != NULL);
+    heap_free(p);
+    CHECK(heap_alloc_aligned(HEAP_SIZE * 2, 64) == NULL);
+    CHECK(heap_alloc_aligned(HEAP_SIZE - 64, 4096) == NULL);
+    
+    MemStats stats;
+    heap_get_stats(&stats);
+    CHECK_EQ(stats.in_use, 0);
+    CHECK_EQ(stats.allocations, 0);
+}
+
+// Bloco de linhas inteiras (como os de dma_realloc): cresce e encolhe no
+// lugar, mantendo o alinhamento; só move quando o vizinho está ocupado
+static void test_aligned_realloc(void) {
+    // Heap vazio: o vizinho sai logo depois do bloco
+    heap_init(region + 3, HEAP_SIZE);
+    
+    uint8_t *p = heap_alloc_aligned(192, 64);
+    // Acima das listas rápidas: liberado, funde-se ao resto livre
+    void *neighbour = heap_alloc(1024);
+    CHECK(p != NULL && neighbour != NULL);
+    memset(p, 0x5A, 192);
+    heap_free(neighbour);
+    
+    uint8_t *grown = heap_realloc_aligned(p, 640, 64);
+    CHECK(grown == p);
+    CHECK(heap_usable_size(grown) >= 640);
+    CHECK_EQ(grown[191], 0x5A);
+    p = grown;
+    
+    grown = heap_realloc_aligned(p, 128, 64);
+    CHECK(grown == p);
+    p = grown;
+    CHECK(heap_usable_size(grown) < 640);
+    CHECK(heap_check());
+    
+    // Vizinho em uso: move para outro bloco alinhado, com os dados
+    neighbour = heap_alloc(1024);
+    uint8_t *moved = heap_realloc_aligned(p, 4096, 64);
+    CHECK(moved != NULL && moved != p);
+    CHECK_EQ((uintptr_t)moved & 63, 0);
+    CHECK_EQ(moved[0], 0x5A);
+    CHECK_EQ(moved[127], 0x5A);
+    heap_free(moved);
+    heap_free(neighbour);
+    
+    CHECK(heap_check());
+    MemStats stats;
+    heap_get_stats(&stats);
+    CHECK_EQ(stats.in_use, 0);
+}
+
+static void test_edge_cases(void) {
+    // realloc(NULL, n) aloca; realloc(p, 0) libera
+    void *p = heap_realloc(NULL, 0);
+    CHECK(p != NULL);
+    heap_free(p);
+    
+    p = heap_realloc(NULL, 100);
+    CHECK(p != NULL);
+    CHECK(heap_realloc(p, 0) == NULL);
+    
+    // Estouro em count * size, e pedidos maiores que o heap
+    CHECK(heap_calloc((size_t)-1 / 2, 4) == NULL);
+    CHECK(heap_alloc(HEAP_SIZE * 2) == NULL);
+    
+    p = heap_alloc(10);
+    CHECK(heap_realloc(p, HEAP_SIZE * 2) == NULL);
+    heap_free(p);
+    heap_free(NULL);
+    
+    CHECK(heap_check());
+    MemStats stats;
+    heap_get_stats(&stats);
+    CHECK_EQ(stats.in_use, 0);
+}
+
+int main(void) {
+    // Base desalinhada de propósito
+    heap_init(region + 3, HEAP_SIZE);
+    CHECK(heap_check());
+    
+    stress();
+    free_all();
+    test_edge_cases();
+    test_aligned();
+    test_aligned_realloc();
+    return test_result("test_heap");
+}
@@ -0,0 +1,208 @@
+//
+// test_input.c - Eventos de teclado a partir de relatórios HID sintéticos
+//
+// input_report() contra a sequência esperada de key-down/key-up (troca de
+// teclas num só relatório, ErrorRollOver, fila cheia) e o caminho até o
+// jogo: curvas de um mesmo passo enfileiradas em ordem, até
+// TURN_BUFFER_SIZE, aplicadas uma por passo.
+//
+
+#include "game.h"
+#include "host.h"
+#include "input.h"
+#include "platform.h"
+#include "test.h"
+
+static InputQueue queue;
+
+static void report(uint8_t modifiers, uint8_t k0, uint8_t k1, uint8_t k2, uint64_t time_us) {
+    const uint8_t keys[INPUT_REPORT_KEYS] = { k0, k1, k2 };
+    input_report(&queue, modifiers, keys, time_us);
+}
+
+// Próximo evento da fila deve ser exatamente este
+static void expect_event(uint8_t key, bool pressed, uint8_t modifiers, uint64_t time_us) {
+    InputEvent event;
+    if (!input_next_event(&queue, &event)) {
+        fprintf(stderr, "esperado evento %02x %s, fila vazia\n", key, pressed ? "down" : "up");
+        test_failures++;
+        return;
+    }
+    CHECK_EQ(event.key, key);
+    CHECK_EQ(event.pressed, pressed);
+    CHECK_EQ(event.modifiers, modifiers);
+    CHECK_EQ(event.time_us, time_us);
+}
+
+static void expect_empty(void) {
+    InputEvent event;
+    CHECK(!input_next_event(&queue, &event));
+}
+
+static void test_report_diffs(void) {
+    input_init(&queue);
+    
+    report(0, KEY_UP_1, 0, 0, 100);
+    expect_event(KEY_UP_1, true, 0, 100);
+    expect_empty();
+    
+    // O mesmo relatório repetido (tecla segurada) não gera nada
+    report(0, KEY_UP_1, 0, 0, 200);
+    expect_empty();
+    
+    // Troca no mesmo relatório: solta a antiga antes de pressionar a nova
+    report(0, KEY_LEFT_1, 0, 0, 300);
+    expect_event(KEY_UP_1, false, 0, 300);
+    expect_event(KEY_LEFT_1, true, 0, 300);
+    expect_empty();
+    
+    // Duas teclas novas, na ordem do relatório, com os modificadores dele;
+    // a que continua pressionada muda de posição sem gerar evento
+    report(0x02, KEY_DOWN_1, KEY_RIGHT_1, KEY_LEFT_1, 400);
+    expect_event(KEY_DOWN_1, true, 0x02, 400);
+    expect_event(KEY_RIGHT_1, true, 0x02, 400);
+    expect_empty();
+    
+    // Pressionada e solta entre dois relatórios: key-down e key-up
+    report(0, KEY_LEFT_1, KEY_PAUSE_1, 0, 500);
+    expect_event(KEY_DOWN_1, false, 0, 500);
+    expect_event(KEY_RIGHT_1, false, 0, 500);
+    expect_event(KEY_PAUSE_1, true, 0, 500);
+    expect_empty();
+    
+    report(0, 0, 0, 0, 600);
+    expect_event(KEY_LEFT_1, false, 0, 600);
+    expect_event(KEY_PAUSE_1, false, 0, 600);
+    expect_empty();
+    CHECK_EQ(queue.dropped, 0);
+}
+
+static void test_error_rollover(void) {
+    input_init(&queue);
+    
+    report(0, KEY_UP_1, KEY_LEFT_1, 0, 10);
+    expect_event(KEY_UP_1, true, 0, 10);
+    expect_event(KEY_LEFT_1, true, 0, 10);
+    
+    // Teclas demais: o relatório é todo ErrorRollOver e não diz nada
+    const uint8_t rollover[INPUT_REPORT_KEYS] = {
+        HID_ERROR_ROLLOVER, HID_ERROR_ROLLOVER, HID_ERROR_ROLLOVER,
+        HID_ERROR_ROLLOVER, HID_ERROR_ROLLOVER, HID_ERROR_ROLLOVER
+    };
+    input_report(&queue, 0, rollover, 20);
+    expect_empty();
+    
+    // O estado de antes do rollover continua: só LEFT foi solta
+    report(0, KEY_UP_1, 0, 0, 30);
+    expect_event(KEY_LEFT_1, false, 0, 30);
+    expect_empty();
+}
+
+// Com a fila cheia os eventos seguintes são contados e descartados; os que
+// entraram saem intactos e em ordem
+static void test_queue_full(void) {
+    input_init(&queue);
+    
+    int reports = INPUT_QUEUE_SIZE;     // Um key-down e um key-up cada
+    for (int i = 0; i < reports; i++) {
+        report(0, (uint8_t)(0x04 + i), 0, 0, i);
+        report(0, 0, 0, 0, i);
+    }
+    CHECK_EQ(queue.dropped, reports * 2 - INPUT_QUEUE_SIZE);
+    
+    for (int i = 0; i < INPUT_QUEUE_SIZE / 2; i++) {
+        expect_event((uint8_t)(0x04 + i), true, 0, i);
+        expect_event((uint8_t)(0x04 + i), false, 0, i);
+    }
+    expect_empty();
+    
+    report(0, KEY_UP_1, 0, 0, 1000);
+    expect_event(KEY_UP_1, true, 0, 1000);
+}
+
+// ================================
+// ATÉ O JOGO
+// ================================
+
+static Game game;
+
+static void new_game(void) {
+    game_seed(&game, 1);
+    init_game(&game);
+    platform_input_init();
+}
+
+static void tap(unsigned char key) {
+    host_push_key(key);
+}
+
+static Direction step_direction(void) {
+    platform_poll_input(&game);
+    game_step(&game);
+    return game.snake.direction;
+}
+
+static void test_turn_buffer(void) {
+    new_game();
+    CHECK_EQ(game.snake.direction, DIR_RIGHT);
+    
+    // Cinco toques dentro de um passo: as três primeiras curvas entram, em
+    // ordem; com o buffer cheio as demais são descartadas
+    tap(KEY_UP_1);
+    tap(KEY_LEFT_1);
+    tap(KEY_UP_2);
+    tap(KEY_RIGHT_1);
+    tap(KEY_DOWN_1);
+    platform_poll_input(&game);
+    CHECK_EQ(game.snake.turn_count, TURN_BUFFER_SIZE);
+    CHECK_EQ(game.snake.turns[0], DIR_UP);
+    CHECK_EQ(game.snake.turns[1], DIR_LEFT);
+    CHECK_EQ(game.snake.turns[2], DIR_UP);
+    
+    // Uma curva por passo
+    game_step(&game);
+    CHECK_EQ(game.snake.direction, DIR_UP);
+    CHECK_EQ(step_direction(), DIR_LEFT);
+    CHECK_EQ(step_direction(), DIR_UP);
+    CHECK_EQ(step_direction(), DIR_UP);
+    CHECK_EQ(game.snake.turn_count, 0);
+    CHECK_EQ(game.state, GAME_RUNNING);
+    
+    // Reversão e repetição são validadas contra a última curva pendente
+    tap(KEY_LEFT_1);
+    tap(KEY_RIGHT_1);       // Oposta à pendente (LEFT): ignorada
+    tap(KEY_LEFT_2);        // Igual à pendente: ignorada
+    tap(KEY_DOWN_1);        // Oposta à direção atual, mas não à pendente
+    platform_poll_input(&game);
+    CHECK_EQ(game.snake.turn_count, 2);
+    CHECK_EQ(step_direction(), DIR_LEFT);
+    CHECK_EQ(step_direction(), DIR_DOWN);
+}
+
+// Várias teclas num só relatório viram curvas na ordem do relatório; as
+// que continuam pressionadas nos relatórios seguintes não se repetem
+static void test_turns_in_one_report(void) {
+    new_game();
+    
+    const uint8_t both[INPUT_REPORT_KEYS] = { KEY_DOWN_1, KEY_LEFT_1 };
+    host_push_report(0, both);
+    host_push_report(0, both);
+    CHECK_EQ(step_direction(), DIR_DOWN);
+    CHECK_EQ(game.snake.turn_count, 1);
+    CHECK_EQ(step_direction(), DIR_LEFT);
+    
+    // Soltar não gera curva
+    const uint8_t none[INPUT_REPORT_KEYS] = { 0 };
+    host_push_report(0, none);
+    CHECK_EQ(step_direction(), DIR_LEFT);
+    CHECK_EQ(game.snake.turn_count, 0);
+}
+
+int main(void) {
+    test_report_diffs();
+    test_error_rollover();
+    test_queue_full();
+    test_turn_buffer();
+    test_turns_in_one_report();
+    return test_result("test_input");
+}
@@ -0,0 +1,145 @@
+//
+// test_interrupts.c - Tabela de despacho de IRQ sobre o controlador simulado
+//
+// ConnectInterrupt/DisconnectInterrupt registram e habilitam cada linha;
+// irq_dispatch() chama os handlers das linhas pendentes e habilitadas,
+// com o parâmetro registrado, na ordem básicas (64..71), 0..31 e 32..63.
+// Linha pendente sem handler é desabilitada para não travar o core.
+//
+
+#include "interrupts.h"
+#include "host.h"
+#include "test.h"
+
+#define MAX_CALLS   16
+
+static unsigned calls[MAX_CALLS];
+static int call_count;
+
+// O parâmetro de cada handler é o número da linha
+static void record_handler(void *param) {
+    unsigned irq = (unsigned)(uintptr_t)param;
+    if (call_count < MAX_CALLS) {
+        calls[call_count] = irq;
+    }
+    call_count++;
+    host_irq_clear(irq);
+}
+
+// Não limpa a linha: só a desconexão pode pará-la
+static void self_disconnect_handler(void *param) {
+    unsigned irq = (unsigned)(uintptr_t)param;
+    call_count++;
+    DisconnectInterrupt(irq);
+}
+
+static void other_handler(void *param) {
+    (void)param;
+    call_count += 100;
+    host_irq_clear(IRQ_USB);
+}
+
+static void connect(unsigned irq) {
+    ConnectInterrupt(irq, record_handler, (void *)(uintptr_t)irq);
+}
+
+static void dispatch(void) {
+    call_count = 0;
+    irq_dispatch();
+}
+
+static void test_order(void) {
+    static const unsigned lines[] = {IRQ_UART, 0, IRQ_TIMER3, 70, IRQ_TIMER1, 31, 64, 32};
+    static const unsigned expected[] = {64, 70, 0, IRQ_TIMER1, IRQ_TIMER3, 31, 32, IRQ_UART};
+    
+    interrupts_init();
+    for (unsigned i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+        connect(lines[i]);
+        CHECK(host_irq_enabled(lines[i]));
+        host_irq_raise(lines[i]);
+    }
+    
+    dispatch();
+    CHECK_EQ(call_count, 8);
+    for (int i = 0; i < 8; i++) {
+        CHECK_EQ(calls[i], expected[i]);
+    }
+    
+    // Os handlers limparam as linhas: nada mais a despachar
+    dispatch();
+    CHECK_EQ(call_count, 0);
+}
+
+static void test_connect_disconnect(void) {
+    interrupts_init();
+    CHECK(!host_irq_enabled(IRQ_TIMER1));
+    
+    // Linha pendente mas desabilitada não é despachada
+    host_irq_raise(IRQ_TIMER1);
+    dispatch();
+    CHECK_EQ(call_count, 0);
+    
+    connect(IRQ_TIMER1);
+    dispatch();
+    CHECK_EQ(call_count, 1);
+    CHECK_EQ(calls[0], IRQ_TIMER1);
+    
+    // Desconectada: desabilitada e sem handler
+    DisconnectInterrupt(IRQ_TIMER1);
+    CHECK(!host_irq_enabled(IRQ_TIMER1));
+    host_irq_raise(IRQ_TIMER1);
+    dispatch();
+    CHECK_EQ(call_count, 0);
+    host_irq_clear(IRQ_TIMER1);
+    
+    // Reconectar troca handler e parâmetro
+    connect(IRQ_USB);
+    ConnectInterrupt(IRQ_USB, other_handler, NULL);
+    host_irq_raise(IRQ_USB);
+    dispatch();
+    CHECK_EQ(call_count, 100);
+    
+    // Linhas fora da tabela e handler nulo são ignorados
+    ConnectInterrupt(IRQ_LINES, record_handler, NULL);
+    ConnectInterrupt(IRQ_TIMER3, NULL, NULL);
+    CHECK(!host_irq_enabled(IRQ_TIMER3));
+    DisconnectInterrupt(IRQ_LINES);
+    
+    // interrupts_init desabilita tudo
+    interrupts_init();
+    CHECK(!host_irq_enabled(IRQ_USB));
+}
+
+static void test_unowned_and_self_disconnect(void) {
+    interrupts_init();
+    
+    // Habilitada sem handler (pelo firmware, por exemplo): desabilitada no
+    // primeiro despacho em vez de disparar para sempre
+    host_irq_enable(40);
+    host_irq_enable(66);
+    host_irq_raise(40);
+    host_irq_raise(66);
+    dispatch();
+    CHECK_EQ(call_count, 0);
+    CHECK(!host_irq_enabled(40));
+    CHECK(!host_irq_enabled(66));
+    host_irq_clear(40);
+    host_irq_clear(66);
+    
+    // Handler que se desconecta roda uma vez, mesmo com a linha pendente
+    ConnectInterrupt(IRQ_UART, self_disconnect_handler, (void *)(uintptr_t)IRQ_UART);
+    host_irq_raise(IRQ_UART);
+    dispatch();
+    CHECK_EQ(call_count, 1);
+    dispatch();
+    CHECK_EQ(call_count, 0);
+    CHECK(!host_irq_enabled(IRQ_UART));
+    host_irq_clear(IRQ_UART);
+}
+
+int main(void) {
+    test_order();
+    test_connect_disconnect();
+    test_unowned_and_self_disconnect();
+    return test_result("test_interrupts");
+}
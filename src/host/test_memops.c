@@ -0,0 +1,154 @@
+//
+// test_memops.c - memcpy/memmove/memset/memcmp do memops.c contra a libc
+//
+// Todos os desalinhamentos de origem e destino (0 a 15) e comprimentos de
+// 0 a 300, com bytes de guarda dos dois lados; memmove com sobreposição
+// nos dois sentidos; memcmp só pelo sinal, com a diferença em cada posição.
+//
+
+#include <stdbool.h>
+#include <string.h>
+#include "memops_host.h"
+#include "test.h"
+
+#define MAX_LENGTH      300
+#define MAX_OFFSET      16
+#define MAX_SHIFT       40
+#define BUFFER_SIZE     (MAX_LENGTH + 2 * MAX_OFFSET + 2 * MAX_SHIFT + 64)
+#define GUARD_BYTE      0xEE
+
+static uint8_t source[BUFFER_SIZE] __attribute__((aligned(16)));
+static uint8_t actual[BUFFER_SIZE] __attribute__((aligned(16)));
+static uint8_t expected[BUFFER_SIZE] __attribute__((aligned(16)));
+
+static void fill_pattern(uint8_t *buffer, uint32_t seed) {
+    for (int i = 0; i < BUFFER_SIZE; i++) {
+        seed = seed * 1664525 + 1013904223;
+        buffer[i] = (uint8_t)(seed >> 24);
+    }
+}
+
+static bool report(const char *what, int a, int b, int length) {
+    if (memcmp(actual, expected, BUFFER_SIZE) == 0) {
+        return true;
+    }
+    fprintf(stderr, "%s: deslocamentos %d/%d, %d bytes\n", what, a, b, length);
+    test_failures++;
+    return false;
+}
+
+static void test_memcpy(void) {
+    fill_pattern(source, 1);
+    for (int dst = 0; dst < MAX_OFFSET; dst++) {
+        for (int src = 0; src < MAX_OFFSET; src++) {
+            for (int n = 0; n <= MAX_LENGTH; n++) {
+                memset(actual, GUARD_BYTE, BUFFER_SIZE);
+                memset(expected, GUARD_BYTE, BUFFER_SIZE);
+                void *r = memops_memcpy(actual + MAX_OFFSET + dst, source + src, n);
+                memcpy(expected + MAX_OFFSET + dst, source + src, n);
+                CHECK(r == actual + MAX_OFFSET + dst);
+                if (!report("memcpy", dst, src, n)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// Origem e destino no mesmo buffer, a até MAX_SHIFT bytes um do outro,
+// para os dois lados: cópia para frente e para trás
+static void test_memmove(void) {
+    for (int base = 0; base < 8; base++) {
+        for (int shift = -MAX_SHIFT; shift <= MAX_SHIFT; shift++) {
+            for (int n = 0; n <= MAX_LENGTH; n++) {
+                fill_pattern(actual, n + shift);
+                memcpy(expected, actual, BUFFER_SIZE);
+                
+                int src = MAX_SHIFT + base;
+                void *r = memops_memmove(actual + src + shift, actual + src, n);
+                memmove(expected + src + shift, expected + src, n);
+                CHECK(r == actual + src + shift);
+                if (!report("memmove", base, shift, n)) {
+                    return;
+                }
+            }
+        }
+    }
+    
+    // Sem sobreposição, todos os alinhamentos
+    fill_pattern(source, 2);
+    for (int dst = 0; dst < MAX_OFFSET; dst++) {
+        for (int src = 0; src < MAX_OFFSET; src++) {
+            for (int n = 0; n <= MAX_LENGTH; n += 7) {
+                memset(actual, GUARD_BYTE, BUFFER_SIZE);
+                memset(expected, GUARD_BYTE, BUFFER_SIZE);
+                memops_memmove(actual + dst, source + src, n);
+                memmove(expected + dst, source + src, n);
+                if (!report("memmove disjunto", dst, src, n)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static void test_memset(void) {
+    // Só o byte baixo de c conta
+    static const int values[] = {0, 0xA5, 0xFF, 0x1234, -1};
+    
+    for (unsigned v = 0; v < sizeof(values) / sizeof(values[0]); v++) {
+        for (int dst = 0; dst < MAX_OFFSET; dst++) {
+            for (int n = 0; n <= MAX_LENGTH; n++) {
+                memset(actual, GUARD_BYTE, BUFFER_SIZE);
+                memset(expected, GUARD_BYTE, BUFFER_SIZE);
+                void *r = memops_memset(actual + dst, values[v], n);
+                memset(expected + dst, values[v], n);
+                CHECK(r == actual + dst);
+                if (!report("memset", dst, values[v], n)) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+static int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+// Buffers iguais com um byte diferente em cada posição, para cima e para
+// baixo (bytes comparados sem sinal: 0x80 > 0x7F)
+static void test_memcmp(void) {
+    for (int a = 0; a < 8; a++) {
+        for (int b = 0; b < 8; b++) {
+            for (int n = 0; n <= 80; n++) {
+                fill_pattern(source, n);
+                uint8_t *x = actual + a;
+                uint8_t *y = expected + b;
+                memcpy(x, source, n);
+                memcpy(y, source, n);
+                CHECK_EQ(memops_memcmp(x, y, n), 0);
+                
+                for (int at = 0; at < n; at++) {
+                    uint8_t saved = y[at];
+                    y[at] = x[at] ^ 0x80;
+                    if (sign(memops_memcmp(x, y, n)) != sign(memcmp(x, y, n))) {
+                        fprintf(stderr, "memcmp: deslocamentos %d/%d, %d bytes, diferença em %d\n",
+                                a, b, n, at);
+                        test_failures++;
+                        return;
+                    }
+                    y[at] = saved;
+                }
+            }
+        }
+    }
+}
+
+int main(void) {
+    test_memcpy();
+    test_memmove();
+    test_memset();
+    test_memcmp();
+    return test_result("test_memops");
+}
@@ -0,0 +1,225 @@
+//
+// test_pool_arena.c - Esgotamento e reuso dos pools e da arena de frame
+//
+// Pool: todos os blocos distintos e alinhados, recusa contada quando
+// esgota, e depois de liberar tudo (em qualquer ordem) os mesmos blocos
+// voltam a ser entregues. Duas threads disputando o pool nunca recebem o
+// mesmo bloco. Arena: enche, recusa, e o reset devolve tudo de uma vez.
+//
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+#include "pool.h"
+#include "test.h"
+
+#define POOL_BLOCKS     100
+#define POOL_BLOCK_SIZE 24
+#define ARENA_SIZE      4096
+
+#define THREAD_BLOCKS   64
+#define THREAD_ROUNDS   200000
+
+static uint8_t pool_memory[POOL_REGION_SIZE(POOL_BLOCK_SIZE, POOL_BLOCKS)] __attribute__((aligned(POOL_ALIGN)));
+static uint8_t thread_memory[POOL_REGION_SIZE(64, THREAD_BLOCKS)] __attribute__((aligned(POOL_ALIGN)));
+static uint8_t arena_memory[ARENA_SIZE + 16];
+
+static uint32_t random_state = 77;
+
+static uint32_t test_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+// Esvazia o pool e confere os blocos: distintos, alinhados e dentro da região
+static int drain(Pool *pool, void **blocks) {
+    int count = 0;
+    void *ptr;
+    while ((ptr = pool_alloc(pool)) != NULL) {
+        CHECK(pool_owns(pool, ptr));
+        CHECK_EQ((uintptr_t)ptr % POOL_ALIGN, 0);
+        CHECK_EQ(((uint8_t *)ptr - pool_memory) % pool->block_size, 0);
+        for (int i = 0; i < count; i++) {
+            CHECK(blocks[i] != ptr);
+        }
+        blocks[count++] = ptr;
+        if (count > POOL_BLOCKS) {
+            break;
+        }
+    }
+    return count;
+}
+
+static int compare_pointers(const void *a, const void *b) {
+    uintptr_t x = (uintptr_t)*(void *const *)a;
+    uintptr_t y = (uintptr_t)*(void *const *)b;
+    return (x > y) - (x < y);
+}
+
+static void test_pool_exhaustion(void) {
+    Pool pool;
+    void *blocks[POOL_BLOCKS + 1];
+    void *again[POOL_BLOCKS + 1];
+    MemStats stats;
+    
+    CHECK(pool_init(&pool, pool_memory, POOL_BLOCK_SIZE, POOL_BLOCKS));
+    CHECK_EQ(pool.block_size, 32);
+    
+    CHECK_EQ(drain(&pool, blocks), POOL_BLOCKS);
+    CHECK(pool_alloc(&pool) == NULL);
+    pool_get_stats(&pool, &stats);
+    CHECK_EQ(stats.allocations, POOL_BLOCKS);
+    CHECK_EQ(stats.failed, 2);
+    CHECK_EQ(stats.free_bytes, 0);
+    CHECK_EQ(stats.largest_free, 0);
+    
+    // Liberar em ordem aleatória e esvaziar de novo: mesmos blocos
+    for (int i = POOL_BLOCKS - 1; i > 0; i--) {
+        int j = test_random() % (i + 1);
+        void *t = blocks[i];
+        blocks[i] = blocks[j];
+        blocks[j] = t;
+    }
+    for (int i = 0; i < POOL_BLOCKS; i++) {
+        pool_free(&pool, blocks[i]);
+    }
+    pool_free(&pool, NULL);
+    pool_get_stats(&pool, &stats);
+    CHECK_EQ(stats.allocations, 0);
+    CHECK_EQ(stats.free_bytes, stats.size);
+    CHECK_EQ(stats.peak_in_use, stats.size);
+    
+    CHECK_EQ(drain(&pool, again), POOL_BLOCKS);
+    qsort(blocks, POOL_BLOCKS, sizeof(void *), compare_pointers);
+    qsort(again, POOL_BLOCKS, sizeof(void *), compare_pointers);
+    CHECK(memcmp(blocks, again, sizeof(void *) * POOL_BLOCKS) == 0);
+    
+    // O último liberado é o primeiro reaproveitado (pilha)
+    pool_free(&pool, again[10]);
+    pool_free(&pool, again[20]);
+    CHECK(pool_alloc(&pool) == again[20]);
+    CHECK(pool_alloc(&pool) == again[10]);
+    
+    // Reinicializar devolve tudo
+    CHECK(pool_init(&pool, pool_memory, POOL_BLOCK_SIZE, POOL_BLOCKS));
+    pool_get_stats(&pool, &stats);
+    CHECK_EQ(stats.allocations, 0);
+    CHECK_EQ(stats.failed, 0);
+    CHECK_EQ(drain(&pool, blocks), POOL_BLOCKS);
+    
+    // Parâmetros inválidos e ponteiros de fora
+    CHECK(!pool_init(&pool, NULL, 16, 4));
+    CHECK(!pool_init(&pool, pool_memory, 16, 0));
+    CHECK(!pool_init(&pool, pool_memory, 16, POOL_MAX_BLOCKS + 1));
+    CHECK(pool_init(&pool, pool_memory, POOL_BLOCK_SIZE, POOL_BLOCKS));
+    CHECK(!pool_owns(&pool, pool_memory + sizeof(pool_memory)));
+    CHECK(!pool_owns(&pool, arena_memory));
+}
+
+// Cada thread marca os blocos que recebe e confere a marca antes de
+// devolvê-los: um bloco entregue a duas ao mesmo tempo perde a marca
+static Pool shared_pool;
+static volatile int collisions;
+
+static void *pool_worker(void *arg) {
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    volatile uint32_t *held[8];
+    
+    for (uint32_t round = 0; round < THREAD_ROUNDS; round++) {
+        int count = 0;
+        for (int i = 0; i < 8; i++) {
+            held[count] = pool_alloc(&shared_pool);
+            if (held[count]) {
+                held[count][1] = id << 24 | round;
+                count++;
+            }
+        }
+        for (int i = 0; i < count; i++) {
+            if (held[i][1] != (id << 24 | round)) {
+                __atomic_add_fetch(&collisions, 1, __ATOMIC_RELAXED);
+            }
+            pool_free(&shared_pool, (void *)held[i]);
+        }
+    }
+    return NULL;
+}
+
+static void test_pool_threads(void) {
+    pthread_t threads[4];
+    
+    CHECK(pool_init(&shared_pool, thread_memory, 64, THREAD_BLOCKS));
+    for (uintptr_t i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, pool_worker, (void *)(i + 1));
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    
+    CHECK_EQ(collisions, 0);
+    CHECK_EQ(shared_pool.in_use, 0);
+    CHECK(shared_pool.peak <= THREAD_BLOCKS);
+    
+    // A lista livre continua inteira depois da disputa
+    int count = 0;
+    while (count <= THREAD_BLOCKS && pool_alloc(&shared_pool)) {
+        count++;
+    }
+    CHECK_EQ(count, THREAD_BLOCKS);
+}
+
+static void test_arena(void) {
+    Arena arena;
+    MemStats stats;
+    
+    // Memória desalinhada: a arena começa no próximo múltiplo de 16
+    arena_init(&arena, arena_memory + 5, ARENA_SIZE);
+    CHECK_EQ((uintptr_t)arena.base % ARENA_ALIGN, 0);
+    CHECK_EQ(arena.size, ARENA_SIZE - 11);
+    
+    // Tamanhos arredondados para 16, blocos contíguos
+    uint8_t *first = arena_alloc(&arena, 1);
+    uint8_t *second = arena_alloc(&arena, 17);
+    uint8_t *third = arena_alloc(&arena, 0);
+    CHECK(first == arena.base);
+    CHECK(second == first + 16);
+    CHECK(third == second + 32);
+    
+    // Enche até recusar; a recusa não mexe no que já foi entregue
+    int count = 3;
+    while (arena_alloc(&arena, 100)) {
+        count++;
+    }
+    arena_get_stats(&arena, &stats);
+    CHECK_EQ(stats.failed, 1);
+    CHECK_EQ(stats.allocations, count);
+    CHECK(stats.free_bytes < 112);
+    CHECK(arena_alloc(&arena, stats.free_bytes + 1) == NULL);
+    CHECK(arena_alloc(&arena, (size_t)-8) == NULL);
+    size_t peak = arena.used;
+    
+    // Reset: tudo disponível de novo, a partir do início; o pico fica
+    arena_reset(&arena);
+    arena_get_stats(&arena, &stats);
+    CHECK_EQ(stats.in_use, 0);
+    CHECK_EQ(stats.allocations, 0);
+    CHECK_EQ(stats.peak_in_use, peak);
+    CHECK(arena_alloc(&arena, 48) == first);
+    
+    // O bloco inteiro de uma vez cabe exatamente
+    arena_reset(&arena);
+    CHECK(arena_alloc(&arena, arena.size & ~(size_t)(ARENA_ALIGN - 1)) == first);
+    CHECK(arena_alloc(&arena, 1) == NULL);
+    
+    // Arena menor que o próprio alinhamento
+    arena_init(&arena, arena_memory + 1, 8);
+    CHECK_EQ(arena.size, 0);
+    CHECK(arena_alloc(&arena, 1) == NULL);
+}
+
+int main(void) {
+    test_pool_exhaustion();
+    test_pool_threads();
+    test_arena();
+    return test_result("test_pool_arena");
+}
@@ -0,0 +1,143 @@
+//
+// test_render.c - Renderização incremental contra o redesenho completo
+//
+// draw_game() repinta só as células sujas (e, com double buffering, as do
+// frame anterior, ainda ausentes na página de trás). A cada frame a página
+// exibida deve ser idêntica, pixel a pixel, a um draw_full() do mesmo
+// estado desenhado num buffer à parte, inclusive com a arena do frame
+// esgotada.
+//
+
+#include "../render.c"      // draw_full(), FrameText e o texto de FPS são internos
+
+#include <string.h>
+#include "host.h"
+#include "test.h"
+
+#define SEEDS           3
+#define FRAMES          5000
+
+static Game game;
+static uint16_t reference[SCREEN_WIDTH * SCREEN_HEIGHT];
+
+static uint32_t script_state;
+
+static uint32_t script_random(void) {
+    script_state = script_state * 1664525 + 1013904223;
+    return script_state >> 8;
+}
+
+// Redesenho completo do estado atual no buffer de referência, com os
+// mesmos textos que draw_game() acabou de usar
+static void draw_reference(void) {
+    char score[SCORE_TEXT_MAX];
+    FrameText text;
+    text.score = score;
+    text.score_len = snprintf(score, sizeof(score), "Score: %d", game.score);
+    text.stats = stats_text;
+    text.stats_len = stats_len;
+    
+    uint16_t *back = framebuffer;
+    framebuffer = reference;
+    draw_full(&game, &text);
+    framebuffer = back;
+}
+
+// Teclas aleatórias, inclusive pausa e reinício, para passar pelos overlays
+static void scripted_input(void) {
+    static const unsigned char keys[] = {
+        KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1, KEY_PAUSE_1, KEY_RESTART_1
+    };
+    uint32_t r = script_random();
+    
+    if (game.state == GAME_OVER) {
+        if (r % 16 == 0) {
+            handle_input(&game, KEY_RESTART_1);
+        }
+    } else if (r % 4 == 0) {
+        unsigned index = (r >> 4) % sizeof(keys);
+        // Pausa e reinício são raros: a maior parte dos frames é jogo
+        if (index < 4 || (r >> 12) % 8 == 0) {
+            handle_input(&game, keys[index]);
+        }
+    }
+}
+
+static bool run_seed(uint32_t seed) {
+    game_seed(&game, seed);
+    init_game(&game);
+    script_state = seed;
+    
+    uint32_t offset = host_display_offset();
+    for (int frame = 0; frame < FRAMES; frame++) {
+        scripted_input();
+        
+        // 0 a 2 passos por frame: frames sem dano e dano acumulado
+        int steps = script_random() % 3;
+        for (int i = 0; i < steps; i++) {
+            game_step(&game);
+        }
+        
+        draw_game(&game);
+        
+        // Cada frame troca a página exibida
+        if (graphics_page_count() > 1) {
+            CHECK(host_display_offset() != offset);
+            offset = host_display_offset();
+        }
+        
+        draw_reference();
+        const uint16_t *shown = host_display_page();
+        for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+            if (shown[i] != reference[i]) {
+                fprintf(stderr, "semente %u frame %d: pixel (%d, %d) = %04x, esperado %04x\n",
+                        seed, frame, i % SCREEN_WIDTH, i / SCREEN_WIDTH, shown[i], reference[i]);
+                test_failures++;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Com a arena do frame esgotada o placar sai da pilha, sem diferença
+static void test_arena_exhausted(void) {
+    game_seed(&game, 9);
+    init_game(&game);
+    draw_game(&game);
+    
+    while (arena_alloc(&frame_arena, ARENA_ALIGN)) {
+    }
+    game.score = 1230;
+    game.dirty.full_redraw = true;
+    draw_game(&game);
+    
+    draw_reference();
+    const uint16_t *shown = host_display_page();
+    for (int i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+        if (shown[i] != reference[i]) {
+            fprintf(stderr, "arena esgotada: pixel (%d, %d) difere\n", i % SCREEN_WIDTH, i / SCREEN_WIDTH);
+            test_failures++;
+            return;
+        }
+    }
+    
+    // O reset no fim do frame devolve a arena
+    MemStats stats;
+    render_get_frame_stats(&stats);
+    CHECK_EQ(stats.in_use, 0);
+}
+
+int main(void) {
+    init_graphics();
+    profile_init();
+    CHECK_EQ(graphics_page_count(), 2);
+    
+    for (uint32_t seed = 1; seed <= SEEDS; seed++) {
+        if (!run_seed(seed)) {
+            break;
+        }
+    }
+    test_arena_exhausted();
+    return test_result("test_render");
+}
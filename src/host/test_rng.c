@@ -0,0 +1,120 @@
+//
+// test_rng.c - Vetores conhecidos do xoshiro128** e uniformidade de rng_range
+//
+// As primeiras saídas para o estado {1, 2, 3, 4} são as da implementação de
+// referência; as de rng_seed() fixam a expansão da semente (um replay antigo
+// só reproduz se ela não mudar). rng_range() passa por um qui-quadrado em
+// cada limite pequeno e num limite em que a rejeição de Lemire é frequente.
+//
+
+#include "rng.h"
+#include "test.h"
+
+#define SAMPLES_PER_BUCKET  4000
+#define MAX_BOUND           16
+
+// Qui-quadrado crítico a p = 0,001 para 1 a 15 graus de liberdade
+static const double chi2_critical[MAX_BOUND] = {
+    0.0, 10.83, 13.82, 16.27, 18.47, 20.52, 22.46, 24.32,
+    26.12, 27.88, 29.59, 31.26, 32.91, 34.53, 36.12, 37.70
+};
+
+static void test_reference_vectors(void) {
+    static const uint32_t expected[] = {
+        11520, 0, 5927040, 70819200, 2031721883,
+        1637235492, 1287239034, 3734860849u, 3729100597u, 4258142804u
+    };
+    Rng rng = { { 1, 2, 3, 4 } };
+    
+    for (unsigned i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        CHECK_EQ(rng_next(&rng), expected[i]);
+    }
+}
+
+static void test_seeded_vectors(void) {
+    Rng rng;
+    
+    // Semente 0 também gera estado não nulo
+    rng_seed(&rng, 0);
+    CHECK_EQ(rng.s[0], 0x92CA2F0Eu);
+    CHECK_EQ(rng.s[1], 0x3CD6E3F3u);
+    CHECK_EQ(rng.s[2], 0x1B147DCCu);
+    CHECK_EQ(rng.s[3], 0x4C081DBFu);
+    CHECK_EQ(rng_next(&rng), 3809008728u);
+    CHECK_EQ(rng_next(&rng), 1133695204u);
+    CHECK_EQ(rng_next(&rng), 53579671u);
+    
+    rng_seed(&rng, 12345);
+    CHECK_EQ(rng_next(&rng), 518667457u);
+    CHECK_EQ(rng_next(&rng), 440444462u);
+    CHECK_EQ(rng_next(&rng), 4232892992u);
+    CHECK_EQ(rng_next(&rng), 3757857622u);
+}
+
+static double chi_square(const uint32_t *counts, uint32_t buckets, uint32_t samples) {
+    double expected = (double)samples / buckets;
+    double sum = 0.0;
+    
+    for (uint32_t i = 0; i < buckets; i++) {
+        double diff = counts[i] - expected;
+        sum += diff * diff / expected;
+    }
+    return sum;
+}
+
+static void test_small_bounds(void) {
+    Rng rng;
+    rng_seed(&rng, 2024);
+    
+    for (uint32_t i = 0; i < 100; i++) {
+        CHECK_EQ(rng_range(&rng, 1), 0);
+    }
+    
+    for (uint32_t bound = 2; bound <= MAX_BOUND; bound++) {
+        uint32_t counts[MAX_BOUND] = { 0 };
+        uint32_t samples = bound * SAMPLES_PER_BUCKET;
+        
+        for (uint32_t i = 0; i < samples; i++) {
+            uint32_t value = rng_range(&rng, bound);
+            if (value >= bound) {
+                fprintf(stderr, "rng_range(%u) = %u\n", bound, value);
+                test_failures++;
+                return;
+            }
+            counts[value]++;
+        }
+        
+        double chi2 = chi_square(counts, bound, samples);
+        if (chi2 > chi2_critical[bound - 1]) {
+            fprintf(stderr, "rng_range(%u): qui-quadrado %.2f > %.2f\n",
+                    bound, chi2, chi2_critical[bound - 1]);
+            test_failures++;
+        }
+    }
+}
+
+// Com bound = 3 * 2^30 um quarto das saídas é rejeitado; sem a rejeição,
+// os múltiplos de 3 sairiam com o dobro da frequência dos outros restos
+static void test_rejection(void) {
+    Rng rng;
+    rng_seed(&rng, 7);
+    
+    const uint32_t bound = 0xC0000000u;
+    const uint32_t samples = 3 * SAMPLES_PER_BUCKET * 10;
+    uint32_t counts[3] = { 0 };
+    
+    for (uint32_t i = 0; i < samples; i++) {
+        uint32_t value = rng_range(&rng, bound);
+        CHECK(value < bound);
+        counts[value % 3]++;
+    }
+    CHECK(chi_square(counts, 3, samples) < chi2_critical[2]);
+}
+
+int main(void) {
+    test_reference_vectors();
+    test_seeded_vectors();
+    test_small_bounds();
+    test_rejection();
+    return test_result("test_rng");
+}
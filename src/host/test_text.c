@@ -0,0 +1,131 @@
+//
+// test_text.c - Glifos do atlas contra o desenho bit a bit antigo
+//
+// O desenho antigo testava os 64 bits de cada glifo e chamava draw_pixel()
+// nos acesos. O atlas tem de produzir os mesmos pixels para todo glifo,
+// cor (inclusive com despejo de slots do atlas), posição e recorte.
+//
+
+#include "../graphics.c"    // font_8x8 é interno
+
+#include "test.h"
+
+#define PAGE_PIXELS     (SCREEN_WIDTH * SCREEN_HEIGHT)
+#define TEXT_TRIALS     20000
+
+static uint16_t atlas_result[PAGE_PIXELS];
+
+static uint32_t random_state = 777;
+
+static uint32_t test_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+static int random_between(int lo, int hi) {
+    return lo + (int)(test_random() % (uint32_t)(hi - lo + 1));
+}
+
+// Caminho antigo (anterior ao atlas), como referência
+static void bit_test_draw_char(int x, int y, char c, uint16_t color) {
+    if (c < 32 || c > 126) return;
+    
+    const uint8_t *glyph = font_8x8[c - 32];
+    for (int row = 0; row < 8; row++) {
+        uint8_t line = glyph[row];
+        for (int col = 0; col < 8; col++) {
+            if (line & (0x80 >> col)) {
+                draw_pixel(x + col, y + row, color);
+            }
+        }
+    }
+}
+
+// Fundo com padrão: o glifo não pode tocar os pixels apagados
+static void fill_background(uint32_t seed) {
+    for (int i = 0; i < PAGE_PIXELS; i++) {
+        framebuffer[i] = (uint16_t)(seed + i * 7);
+    }
+}
+
+static void test_glyphs_match_bit_test(void) {
+    // Mais cores que slots no atlas: força o despejo
+    static const uint16_t colors[] = {
+        COLOR_WHITE, COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_YELLOW, COLOR_CYAN
+    };
+    
+    for (int trial = 0; trial < TEXT_TRIALS; trial++) {
+        char c = (char)random_between(31, 127);
+        uint16_t color = colors[test_random() % (sizeof(colors) / sizeof(colors[0]))];
+        int x = random_between(-10, SCREEN_WIDTH + 2);
+        int y = random_between(-10, SCREEN_HEIGHT + 2);
+        bool clipped = trial % 2;
+        int cx = random_between(x - 4, x + 8);
+        int cy = random_between(y - 4, y + 8);
+        int cw = random_between(0, 12);
+        int ch = random_between(0, 12);
+        
+        // Só a região em volta do glifo importa; o resto fica igual
+        fill_background(trial);
+        if (clipped) graphics_set_clip(cx, cy, cw, ch);
+        graphics_draw_char(x, y, c, color);
+        graphics_reset_clip();
+        memcpy(atlas_result, framebuffer, sizeof(atlas_result));
+        
+        fill_background(trial);
+        if (clipped) graphics_set_clip(cx, cy, cw, ch);
+        bit_test_draw_char(x, y, c, color);
+        graphics_reset_clip();
+        
+        if (memcmp(atlas_result, framebuffer, sizeof(atlas_result)) != 0) {
+            fprintf(stderr, "glifo %d ('%c') cor %04x em (%d, %d), recorte %s (%d, %d) %dx%d\n",
+                    c, c, color, x, y, clipped ? "sim" : "não", cx, cy, cw, ch);
+            test_failures++;
+            return;
+        }
+    }
+}
+
+// Strings avançam 8 pixels por caractere, inclusive nos não imprimíveis
+static void test_string_matches_chars(void) {
+    const char *text = "Score: 120\t GAME OVER";
+    
+    fill_background(1);
+    graphics_draw_string(3, 5, text, COLOR_WHITE);
+    memcpy(atlas_result, framebuffer, sizeof(atlas_result));
+    
+    fill_background(1);
+    for (int i = 0; text[i]; i++) {
+        bit_test_draw_char(3 + 8 * i, 5, text[i], COLOR_WHITE);
+    }
+    CHECK(memcmp(atlas_result, framebuffer, sizeof(atlas_result)) == 0);
+}
+
+static void test_text_cache(void) {
+    TextCache cache = {0};
+    
+    CHECK(!graphics_text_cache_matches(&cache, 10, 10, "Score: 0", COLOR_WHITE));
+    graphics_text_cache_store(&cache, 10, 10, "Score: 0", COLOR_WHITE);
+    CHECK(graphics_text_cache_matches(&cache, 10, 10, "Score: 0", COLOR_WHITE));
+    CHECK_EQ(cache.width, 8 * 8);
+    
+    CHECK(!graphics_text_cache_matches(&cache, 10, 10, "Score: 10", COLOR_WHITE));
+    CHECK(!graphics_text_cache_matches(&cache, 10, 10, "Score:", COLOR_WHITE));
+    CHECK(!graphics_text_cache_matches(&cache, 11, 10, "Score: 0", COLOR_WHITE));
+    CHECK(!graphics_text_cache_matches(&cache, 10, 10, "Score: 0", COLOR_RED));
+    
+    // Texto longo é truncado no cache
+    char longer[TEXT_CACHE_MAX_LEN + 8];
+    memset(longer, 'x', sizeof(longer) - 1);
+    longer[sizeof(longer) - 1] = '\0';
+    graphics_text_cache_store(&cache, 0, 0, longer, COLOR_WHITE);
+    CHECK_EQ(cache.width, (TEXT_CACHE_MAX_LEN - 1) * 8);
+}
+
+int main(void) {
+    init_graphics();
+    test_glyphs_match_bit_test();
+    test_string_matches_chars();
+    test_text_cache();
+    return test_result("test_text");
+}
@@ -0,0 +1,262 @@
+//
+// test_timer_wheel.c - Roda de timers contra uma agenda de referência
+//
+// Cada timer deve expirar uma única vez, exatamente no tick calculado
+// (nunca antes do pedido), em qualquer nível da roda ou na lista de
+// estouro. Também: handles velhos, timers reagendados pelo próprio handler
+// e tempos que passam de 2^32 (us e ticks), onde o contador de 32 bits
+// antigo dava a volta.
+//
+
+#include <stdlib.h>
+#include "timer_wheel.h"
+#include "test.h"
+
+#define MAX_TRACKED     4096
+#define KERNEL_TICK_US  10000       // Tick dos timers do kernel (100 Hz)
+
+typedef struct {
+    unsigned handle;
+    uint64_t due;                   // Tick em que deve expirar
+    int fired;
+    bool cancelled;
+} Tracked;
+
+static TimerWheel wheel;
+static Tracked tracked[MAX_TRACKED];
+static int tracked_count;
+
+static uint32_t random_state;
+
+static uint32_t test_random(void) {
+    random_state = random_state * 1664525 + 1013904223;
+    return random_state >> 8;
+}
+
+static uint64_t random_below(uint64_t limit) {
+    uint64_t r = ((uint64_t)test_random() << 24) | test_random();
+    return limit ? r % limit : 0;
+}
+
+static void on_expire(unsigned handle, void *param, void *context) {
+    Tracked *t = param;
+    (void)context;
+    CHECK_EQ(handle, t->handle);
+    CHECK_EQ(wheel.now, t->due);
+    CHECK(!t->cancelled);
+    t->fired++;
+}
+
+// Os blocos de timers só são liberados aqui: a roda não tem destrutor
+static void wheel_reset(uint64_t tick_us) {
+    for (uint32_t i = 0; i < wheel.allocated; i += TIMER_WHEEL_CHUNK) {
+        free(wheel.chunks[i / TIMER_WHEEL_CHUNK]);
+    }
+    timer_wheel_init(&wheel, tick_us);
+    tracked_count = 0;
+}
+
+static Tracked *track(uint64_t now_us, uint64_t delay_us) {
+    Tracked *t = &tracked[tracked_count++];
+    t->fired = 0;
+    t->cancelled = false;
+    t->handle = timer_wheel_start(&wheel, now_us, delay_us, on_expire, t, NULL);
+    CHECK(t->handle != 0);
+    
+    // Arredondado para cima, e no mínimo o próximo tick
+    t->due = (now_us + delay_us + wheel.tick_us - 1) / wheel.tick_us;
+    if (t->due <= wheel.now) {
+        t->due = wheel.now + 1;
+    }
+    return t;
+}
+
+// Tudo que venceu expirou uma vez; nada além disso
+static bool check_fired(void) {
+    for (int i = 0; i < tracked_count; i++) {
+        const Tracked *t = &tracked[i];
+        int expected = (!t->cancelled && t->due <= wheel.now) ? 1 : 0;
+        if (t->fired != expected) {
+            fprintf(stderr, "timer %d: prazo %llu, agora %llu, expirou %d vez(es)\n", i,
+                    (unsigned long long)t->due, (unsigned long long)wheel.now, t->fired);
+            test_failures++;
+            return false;
+        }
+    }
+    return true;
+}
+
+static uint32_t count_pending(void) {
+    uint32_t pending = 0;
+    for (int i = 0; i < tracked_count; i++) {
+        pending += !tracked[i].cancelled && !tracked[i].fired;
+    }
+    return pending;
+}
+
+// Limites de cada nível (64, 64^2, 64^3, 64^4 ticks) e a lista de estouro
+static void test_level_boundaries(void) {
+    static const uint64_t delays[] = {
+        0, 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145,
+        (1u << 24) - 1, 1u << 24, (1u << 24) + 1, 3u * (1u << 24) + 12345
+    };
+    
+    wheel_reset(1);
+    uint64_t now = 1000;
+    for (unsigned i = 0; i < sizeof(delays) / sizeof(delays[0]); i++) {
+        track(now, delays[i]);
+    }
+    CHECK_EQ(wheel.active, tracked_count);
+    
+    // Avança até cada prazo: um tick antes nada, no tick ele expira
+    for (int i = 0; i < tracked_count; i++) {
+        uint64_t due = tracked[i].due;
+        if (due - 1 > wheel.now) {
+            timer_wheel_advance(&wheel, due - 1);
+            CHECK_EQ(tracked[i].fired, 0);
+        }
+        timer_wheel_advance(&wheel, due);
+        if (!check_fired()) {
+            break;
+        }
+    }
+    CHECK_EQ(wheel.active, 0);
+}
+
+// Agenda aleatória com cancelamentos no meio, avançando em saltos
+// irregulares a partir de 'start_us'
+static void run_schedule(uint64_t tick_us, uint64_t start_us, uint64_t max_delay_ticks,
+                         int count, uint32_t seed) {
+    wheel_reset(tick_us);
+    random_state = seed;
+    uint64_t now = start_us;
+    
+    int max_bits = 0;
+    while ((1ull << max_bits) < max_delay_ticks) {
+        max_bits++;
+    }
+    
+    // Atrasos distribuídos entre os níveis: log-uniformes, em us
+    for (int i = 0; i < count; i++) {
+        uint64_t span = 1ull << (test_random() % (max_bits + 1));
+        track(now, random_below(span * tick_us));
+    }
+    
+    while (count_pending() > 0) {
+        // Cancela um pendente de vez em quando; o segundo cancelamento falha
+        if (test_random() % 4 == 0) {
+            Tracked *t = &tracked[test_random() % tracked_count];
+            if (!t->fired && !t->cancelled) {
+                CHECK(timer_wheel_cancel(&wheel, t->handle));
+                t->cancelled = true;
+                CHECK(!timer_wheel_cancel(&wheel, t->handle));
+            }
+        }
+        
+        uint64_t step = test_random() % 2 ? random_below(max_delay_ticks / 16 + 2)
+                                          : test_random() % 3;
+        now += step * tick_us + test_random() % tick_us;
+        timer_wheel_advance(&wheel, now);
+        
+        CHECK_EQ(wheel.active, count_pending());
+        if (!check_fired()) {
+            return;
+        }
+    }
+    CHECK_EQ(wheel.active, 0);
+}
+
+static void test_stale_handles(void) {
+    wheel_reset(1);
+    
+    Tracked *first = track(100, 10);
+    timer_wheel_advance(&wheel, 200);
+    CHECK_EQ(first->fired, 1);
+    CHECK(!timer_wheel_cancel(&wheel, first->handle));
+    
+    // O próximo timer reaproveita o nó com outra geração: o handle velho
+    // não o cancela
+    Tracked *second = track(200, 10);
+    CHECK(second->handle != first->handle);
+    CHECK_EQ(second->handle & TIMER_WHEEL_MAX_TIMERS, first->handle & TIMER_WHEEL_MAX_TIMERS);
+    CHECK(!timer_wheel_cancel(&wheel, first->handle));
+    CHECK_EQ(wheel.active, 1);
+    
+    CHECK(timer_wheel_cancel(&wheel, second->handle));
+    second->cancelled = true;
+    CHECK(!timer_wheel_cancel(&wheel, second->handle));
+    CHECK_EQ(wheel.active, 0);
+    
+    // Handles que nunca existiram
+    CHECK(!timer_wheel_cancel(&wheel, 0));
+    CHECK(!timer_wheel_cancel(&wheel, 12345));
+    
+    // O nó cancelado volta a ser usado, e o handle cancelado continua inválido
+    Tracked *third = track(200, 5);
+    CHECK(third->handle != second->handle);
+    CHECK(!timer_wheel_cancel(&wheel, second->handle));
+    timer_wheel_advance(&wheel, 300);
+    check_fired();
+}
+
+// Timer periódico: o handler agenda o próximo (como o USPi faz)
+static int rearm_count;
+
+static void on_rearm(unsigned handle, void *param, void *context) {
+    (void)handle;
+    (void)param;
+    (void)context;
+    CHECK_EQ(wheel.now, (uint64_t)(rearm_count + 1) * 5);
+    rearm_count++;
+    if (rearm_count < 100) {
+        CHECK(timer_wheel_start(&wheel, wheel.now * wheel.tick_us, 5 * wheel.tick_us,
+                                on_rearm, NULL, NULL) != 0);
+    }
+}
+
+static void test_rearm_from_handler(void) {
+    wheel_reset(KERNEL_TICK_US);
+    rearm_count = 0;
+    timer_wheel_start(&wheel, 0, 5 * KERNEL_TICK_US, on_rearm, NULL, NULL);
+    
+    // Um salto só: os timers agendados pelos handlers caem em ticks futuros
+    // e ainda expiram dentro do mesmo avanço
+    CHECK_EQ(timer_wheel_advance(&wheel, 1000 * KERNEL_TICK_US), 100);
+    CHECK_EQ(rearm_count, 100);
+    CHECK_EQ(wheel.active, 0);
+}
+
+// Depois de ~71 minutos o tempo em us passa de 2^32: um prazo de 32 bits
+// dava a volta e o timer expirava na hora
+static void test_32bit_wrap(void) {
+    wheel_reset(KERNEL_TICK_US);
+    uint64_t now = (1ull << 32) - 15000;
+    Tracked *t = track(now, 3 * KERNEL_TICK_US);
+    CHECK(t->due * KERNEL_TICK_US >= (1ull << 32));
+    
+    timer_wheel_advance(&wheel, now + KERNEL_TICK_US);
+    CHECK_EQ(t->fired, 0);
+    timer_wheel_advance(&wheel, now + 3 * KERNEL_TICK_US - 1);
+    CHECK_EQ(t->fired, 0);
+    timer_wheel_advance(&wheel, now + 3 * KERNEL_TICK_US + KERNEL_TICK_US);
+    CHECK_EQ(t->fired, 1);
+    
+    // Agendas inteiras atravessando 2^32 us e 2^32 ticks
+    run_schedule(KERNEL_TICK_US, (1ull << 32) - 2000 * KERNEL_TICK_US, 1 << 14, 1000, 11);
+    run_schedule(1, (1ull << 32) - 5000, 1 << 16, 1000, 12);
+    run_schedule(1, (1ull << 40) - 300, 1 << 20, 500, 13);
+}
+
+int main(void) {
+    test_level_boundaries();
+    test_stale_handles();
+    test_rearm_from_handler();
+    
+    // Até 2^26 ticks: todos os níveis e a lista de estouro
+    run_schedule(1, 1000, 1 << 26, 2000, 1);
+    run_schedule(KERNEL_TICK_US, 0, 1 << 12, MAX_TRACKED, 2);
+    
+    test_32bit_wrap();
+    wheel_reset(1);
+    return test_result("test_timer_wheel");
+}
@@ -0,0 +1,140 @@
+//
+// test_timing.c - FrameClock sobre um relógio simulado
+//
+// O tempo é só um número passado a cada chamada: recuperação de passos
+// atrasados, limite de passos por chamada, cadência de frames e o prazo
+// em que o laço principal acordaria.
+//
+
+#include "timing.h"
+#include "test.h"
+
+#define STEP_US     200000
+#define FRAME_US    16667
+#define START_US    1000000
+
+static void test_catch_up(void) {
+    FrameClock clock;
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    
+    CHECK_EQ(frame_clock_steps(&clock, START_US), 0);
+    CHECK_EQ(frame_clock_steps(&clock, START_US + STEP_US - 1), 0);
+    CHECK_EQ(frame_clock_steps(&clock, START_US + STEP_US), 1);
+    
+    // 3,5 passos de atraso: 3 agora, a metade fica acumulada
+    uint64_t now = START_US + STEP_US + 3 * STEP_US + STEP_US / 2;
+    CHECK_EQ(frame_clock_steps(&clock, now), 3);
+    CHECK_EQ(clock.accumulator, STEP_US / 2);
+    CHECK_EQ(frame_clock_steps(&clock, now + STEP_US / 2), 1);
+    CHECK_EQ(clock.dropped_steps, 0);
+    
+    // Intervalos irregulares não acumulam erro: o total é o tempo decorrido
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    uint64_t total = 0;
+    now = START_US;
+    uint32_t r = 1;
+    for (int i = 0; i < 10000; i++) {
+        r = r * 1664525 + 1013904223;
+        now += (r >> 8) % 350000;
+        total += frame_clock_steps(&clock, now);
+    }
+    CHECK_EQ(total + clock.dropped_steps, (now - START_US) / STEP_US);
+    CHECK_EQ(clock.accumulator, (now - START_US) % STEP_US);
+}
+
+static void test_dropped_steps_cap(void) {
+    FrameClock clock;
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    
+    // Travamento de 20,25 passos: só MAX_CATCHUP_STEPS são simulados
+    uint64_t now = START_US + 20 * STEP_US + STEP_US / 4;
+    CHECK_EQ(frame_clock_steps(&clock, now), MAX_CATCHUP_STEPS);
+    CHECK_EQ(clock.dropped_steps, 20 - MAX_CATCHUP_STEPS);
+    CHECK_EQ(clock.accumulator, STEP_US / 4);
+    
+    // Depois disso, de volta ao ritmo normal
+    CHECK_EQ(frame_clock_steps(&clock, now + STEP_US), 1);
+    CHECK_EQ(frame_clock_steps(&clock, now + 2 * STEP_US), 1);
+    CHECK_EQ(clock.dropped_steps, 20 - MAX_CATCHUP_STEPS);
+    
+    // Exatamente no limite nada é descartado
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    CHECK_EQ(frame_clock_steps(&clock, START_US + MAX_CATCHUP_STEPS * STEP_US), MAX_CATCHUP_STEPS);
+    CHECK_EQ(clock.dropped_steps, 0);
+}
+
+static void test_render_cadence(void) {
+    FrameClock clock;
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    
+    // Primeiro frame imediato, depois um por intervalo
+    CHECK(frame_clock_render_due(&clock, START_US));
+    CHECK(!frame_clock_render_due(&clock, START_US));
+    CHECK(!frame_clock_render_due(&clock, START_US + FRAME_US - 1));
+    CHECK(frame_clock_render_due(&clock, START_US + FRAME_US));
+    
+    // Atraso menor que um frame mantém a grade
+    CHECK(frame_clock_render_due(&clock, START_US + 2 * FRAME_US + 5000));
+    CHECK_EQ(clock.next_frame, START_US + 3 * FRAME_US);
+    
+    // Vários frames perdidos: um só frame e a grade recomeça de agora
+    uint64_t late = START_US + 10 * FRAME_US + 123;
+    CHECK(frame_clock_render_due(&clock, late));
+    CHECK(!frame_clock_render_due(&clock, late + 1));
+    CHECK_EQ(clock.next_frame, late + FRAME_US);
+}
+
+// Laço como o do main: dorme até o prazo, simula, desenha com custo fixo
+static void test_main_loop(uint64_t render_cost_us, uint32_t expected_frames) {
+    FrameClock clock;
+    frame_clock_init(&clock, 0, STEP_US, FRAME_US);
+    uint64_t now = 0;
+    uint32_t steps = 0;
+    uint32_t frames = 0;
+    
+    while (now <= 10 * 1000000) {
+        steps += frame_clock_steps(&clock, now);
+        if (frame_clock_render_due(&clock, now)) {
+            frames++;
+            now += render_cost_us;
+        }
+        
+        uint64_t deadline = frame_clock_next_deadline(&clock);
+        CHECK(deadline > clock.last_time || deadline >= clock.next_frame);
+        if (deadline > now) {
+            now = deadline;
+        }
+    }
+    
+    // 10 s a 200 ms por passo; o custo do desenho não atrasa a simulação
+    CHECK_EQ(steps + clock.dropped_steps, 50);
+    CHECK_EQ(clock.dropped_steps, 0);
+    CHECK_EQ(frames, expected_frames);
+}
+
+static void test_next_deadline(void) {
+    FrameClock clock;
+    frame_clock_init(&clock, START_US, STEP_US, FRAME_US);
+    
+    // Frame devido agora; depois dele, o próximo frame vem antes do passo
+    CHECK_EQ(frame_clock_next_deadline(&clock), START_US);
+    frame_clock_render_due(&clock, START_US);
+    CHECK_EQ(frame_clock_next_deadline(&clock), START_US + FRAME_US);
+    
+    // Sem frames pendentes por perto, o prazo é o do passo
+    clock.next_frame = START_US + 10 * STEP_US;
+    frame_clock_steps(&clock, START_US + STEP_US / 2);
+    CHECK_EQ(frame_clock_next_deadline(&clock), START_US + STEP_US);
+}
+
+int main(void) {
+    test_catch_up();
+    test_dropped_steps_cap();
+    test_render_cadence();
+    test_next_deadline();
+    // De 0 a 10 s inclusive: 600 frames na grade de 16667 us; com custo de
+    // 40 ms, um frame a cada 40 ms, o de 10 s incluído
+    test_main_loop(0, 600);
+    test_main_loop(40000, 251);
+    return test_result("test_timing");
+}
@@ -0,0 +1,79 @@
+//
+// input.c - Eventos de teclado a partir das diferenças entre relatórios HID
+//
+
+#include "input.h"
+
+void input_init(InputQueue *input) {
+    spsc_init(&input->queue, input->slots, sizeof(InputEvent), INPUT_QUEUE_SIZE);
+    for (int i = 0; i < INPUT_REPORT_KEYS; i++) {
+        input->keys[i] = 0;
+    }
+    input->modifiers = 0;
+    input->dropped = 0;
+}
+
+static bool report_has_key(const uint8_t keys[INPUT_REPORT_KEYS], uint8_t key) {
+    for (int i = 0; i < INPUT_REPORT_KEYS; i++) {
+        if (keys[i] == key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void push_event(InputQueue *input, uint8_t key, uint8_t modifiers,
+                       bool pressed, uint64_t time_us) {
+    InputEvent *event = spsc_reserve(&input->queue);
+    if (!event) {
+        input->dropped++;
+        return;
+    }
+    
+    event->time_us = time_us;
+    event->key = key;
+    event->modifiers = modifiers;
+    event->pressed = pressed;
+    spsc_publish(&input->queue);
+}
+
+void input_report(InputQueue *input, uint8_t modifiers,
+                  const uint8_t keys[INPUT_REPORT_KEYS], uint64_t time_us) {
+    // Rollover: o teclado não sabe quais teclas estão pressionadas, então o
+    // estado anterior continua valendo
+    if (keys[0] == HID_ERROR_ROLLOVER) {
+        return;
+    }
+    
+    // Soltas primeiro: uma troca de tecla no mesmo relatório chega como
+    // key-up da antiga e key-down da nova
+    for (int i = 0; i < INPUT_REPORT_KEYS; i++) {
+        uint8_t key = input->keys[i];
+        if (key != 0 && !report_has_key(keys, key)) {
+            push_event(input, key, modifiers, false, time_us);
+        }
+    }
+    
+    for (int i = 0; i < INPUT_REPORT_KEYS; i++) {
+        uint8_t key = keys[i];
+        if (key != 0 && !report_has_key(input->keys, key)) {
+            push_event(input, key, modifiers, true, time_us);
+        }
+    }
+    
+    for (int i = 0; i < INPUT_REPORT_KEYS; i++) {
+        input->keys[i] = keys[i];
+    }
+    input->modifiers = modifiers;
+}
+
+bool input_next_event(InputQueue *input, InputEvent *event) {
+    const InputEvent *slot = spsc_peek(&input->queue);
+    if (!slot) {
+        return false;
+    }
+    
+    *event = *slot;
+    spsc_release(&input->queue);
+    return true;
+}
@@ -0,0 +1,122 @@
+//
+// interrupts.c - Controlador de interrupções e tabela de despacho (Raspberry Pi 3)
+//
+
+#include <stddef.h>
+#include "interrupts.h"
+
+// Registradores do controlador de interrupções (deslocamentos)
+#define IRQ_BASIC_PENDING   0x00
+#define IRQ_PENDING_1       0x04
+#define IRQ_PENDING_2       0x08
+#define IRQ_FIQ_CONTROL     0x0C
+#define IRQ_ENABLE_1        0x10
+#define IRQ_ENABLE_2        0x14
+#define IRQ_ENABLE_BASIC    0x18
+#define IRQ_DISABLE_1       0x1C
+#define IRQ_DISABLE_2       0x20
+#define IRQ_DISABLE_BASIC   0x24
+
+#if (defined(__arm__) || defined(__aarch64__)) && !defined(__linux__)
+#define IRQ_BASE            0x3F00B200
+
+static inline uint32_t irq_read(uint32_t offset) {
+    return *(volatile uint32_t *)((uintptr_t)IRQ_BASE + offset);
+}
+
+static inline void irq_write(uint32_t offset, uint32_t value) {
+    *(volatile uint32_t *)((uintptr_t)IRQ_BASE + offset) = value;
+}
+
+#define irq_barrier(insn)   __asm__ volatile(insn ::: "memory")
+#else
+// Host: controlador simulado (host/interrupts_host.c)
+#include "host.h"
+
+#define irq_read(offset)            host_irq_read(offset)
+#define irq_write(offset, value)    host_irq_write(offset, value)
+#define irq_barrier(insn)           __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+static TInterruptHandler *handlers[IRQ_LINES];
+static void *handler_params[IRQ_LINES];
+
+// Registradores de enable/disable da linha: escrever 1 afeta só aquele bit
+static uint32_t line_register(unsigned irq, bool enable) {
+    if (irq < 32) {
+        return enable ? IRQ_ENABLE_1 : IRQ_DISABLE_1;
+    }
+    if (irq < 64) {
+        return enable ? IRQ_ENABLE_2 : IRQ_DISABLE_2;
+    }
+    return enable ? IRQ_ENABLE_BASIC : IRQ_DISABLE_BASIC;
+}
+
+void interrupts_init(void) {
+    irq_write(IRQ_FIQ_CONTROL, 0);
+    irq_write(IRQ_DISABLE_1, 0xFFFFFFFF);
+    irq_write(IRQ_DISABLE_2, 0xFFFFFFFF);
+    irq_write(IRQ_DISABLE_BASIC, 0xFFFFFFFF);
+    
+    for (unsigned i = 0; i < IRQ_LINES; i++) {
+        handlers[i] = NULL;
+        handler_params[i] = NULL;
+    }
+}
+
+void ConnectInterrupt(unsigned nIRQ, TInterruptHandler *pHandler, void *pParam) {
+    if (nIRQ >= IRQ_LINES || !pHandler) {
+        return;
+    }
+    
+    uint32_t flags = irq_save();
+    handlers[nIRQ] = pHandler;
+    handler_params[nIRQ] = pParam;
+    irq_barrier("dsb sy");
+    irq_write(line_register(nIRQ, true), 1u << (nIRQ % 32));
+    irq_restore(flags);
+}
+
+void DisconnectInterrupt(unsigned nIRQ) {
+    if (nIRQ >= IRQ_LINES) {
+        return;
+    }
+    
+    uint32_t flags = irq_save();
+    irq_write(line_register(nIRQ, false), 1u << (nIRQ % 32));
+    irq_barrier("dsb sy");
+    handlers[nIRQ] = NULL;
+    handler_params[nIRQ] = NULL;
+    irq_restore(flags);
+}
+
+static void dispatch_bits(uint32_t pending, unsigned base) {
+    while (pending) {
+        unsigned bit = __builtin_ctz(pending);
+        pending &= pending - 1;
+        
+        unsigned irq = base + bit;
+        if (handlers[irq]) {
+            handlers[irq](handler_params[irq]);
+        } else {
+            // Linha sem dono: desabilitar para não travar em IRQ contínua
+            irq_write(line_register(irq, false), 1u << bit);
+        }
+    }
+}
+
+void irq_dispatch(void) {
+    irq_barrier("dmb sy");
+    
+    uint32_t basic = irq_read(IRQ_BASIC_PENDING);
+    
+    // Linhas básicas do ARM (bits 0..7)
+    dispatch_bits(basic & 0xFF, 64);
+    
+    // Os bits 8/9 do basic não cobrem as linhas da GPU espelhadas no próprio
+    // basic (USB, UART, ...), então os pendings 1/2 são sempre lidos
+    dispatch_bits(irq_read(IRQ_PENDING_1) & irq_read(IRQ_ENABLE_1), 0);
+    dispatch_bits(irq_read(IRQ_PENDING_2) & irq_read(IRQ_ENABLE_2), 32);
+    
+    irq_barrier("dmb sy");
+}
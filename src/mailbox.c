@@ -0,0 +1,47 @@
+//
+// mailbox.c - Interface de mailbox com o VideoCore (Raspberry Pi 3)
+//
+
+#include "mailbox.h"
+#include "mmu.h"
+
+// Registradores do mailbox 0
+#define MAILBOX_BASE        0x3F00B880
+#define MAILBOX_READ        ((volatile uint32_t*)(MAILBOX_BASE + 0x00))
+#define MAILBOX_STATUS      ((volatile uint32_t*)(MAILBOX_BASE + 0x18))
+#define MAILBOX_WRITE       ((volatile uint32_t*)(MAILBOX_BASE + 0x20))
+
+#define MAILBOX_FULL        0x80000000
+#define MAILBOX_EMPTY       0x40000000
+
+// Alias de barramento sem cache L2 (RPi 2/3)
+#define GPU_MEM_BASE        0xC0000000
+
+bool mailbox_call(uint32_t channel, volatile uint32_t *buffer) {
+    uint32_t message = (((uint32_t)(uintptr_t)buffer | GPU_MEM_BASE) & ~0xF) | (channel & 0xF);
+    
+    // O VideoCore lê e escreve o buffer direto na memória: tirar as linhas
+    // da cache antes de entregá-lo (e descartar as que a espera trouxer)
+    uint32_t size = buffer[0];
+    dcache_clean_invalidate_range(buffer, size);
+    
+    while (*MAILBOX_STATUS & MAILBOX_FULL) {
+        __asm__ volatile("nop");
+    }
+    *MAILBOX_WRITE = message;
+    
+    // Aguardar a resposta no mesmo canal
+    while (true) {
+        while (*MAILBOX_STATUS & MAILBOX_EMPTY) {
+            __asm__ volatile("nop");
+        }
+        if (*MAILBOX_READ == message) {
+            dcache_invalidate_range(buffer, size);
+            return buffer[1] == MAILBOX_RESPONSE_OK;
+        }
+    }
+}
+
+void *mailbox_bus_to_arm(uint32_t bus_address) {
+    return (void*)(uintptr_t)(bus_address & 0x3FFFFFFF);
+}
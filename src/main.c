@@ -4,283 +4,221 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "config.h"
+#include "game.h"
 #include "graphics.h"
+#include "heap.h"
+#include "interrupts.h"
+#include "mmu.h"
+#include "platform.h"
+#include "profile.h"
+#include "render.h"
+#include "replay.h"
+#include "rng.h"
+#include "smp.h"
+#include "spsc.h"
+#include "timing.h"
+#include "timer.h"
+#include "uart.h"
 #include <uspi.h>
 
-// Variáveis globais
+// Instância do jogo
 Game game;
-uint32_t tick_count = 0;
-uint32_t last_input_time = 0;
+
+// Gravação da partida atual (despejada na UART ao fim de cada partida)
+#define REPLAY_BUFFER_SIZE 4096
+static uint8_t replay_buffer[REPLAY_BUFFER_SIZE];
+static ReplayRecorder recorder;
+
+// Renderização no core 1: o core 0 (simulação, USB, timers) publica
+// snapshots imutáveis do jogo; o core 1 os consome e desenha, inclusive a
+// espera de vsync. Sem o core 1, desenha no core 0 como antes.
+#define SNAPSHOT_SLOTS 4
+#if SMP_RENDER
+static uint8_t snapshot_memory[SPSC_REGION_SIZE(sizeof(Game), SNAPSHOT_SLOTS)]
+    __attribute__((aligned(SPSC_ALIGN)));
+static SpscQueue snapshots;
+static Game render_game;        // Cópia de trabalho do core 1
+#endif
+static bool render_on_core1 = false;
+
 extern void init_system(void);
-extern void ProcessKernelTimers(void);
+extern void keyboard_handler(unsigned char ucModifiers, const unsigned char *pKeys);
+extern void DebugHexdump(const void *pBuffer, unsigned nBufLen, const char *pSource);
+extern bool malloc_get_pool_stats(unsigned index, MemStats *stats);
 
 // Declarações de funções
-void handle_input(unsigned char key);
-void spawn_food(void);
-bool check_collision(Position pos);
-void init_game(void);
-void update_game(void);
-void draw_game(void);
-void delay_ms(unsigned int ms);
 void debug_print_game_state(void);
 void init_random(void);
 void init_graphics_system(void);
-uint32_t get_ticks(void);
-void timer_handler(void);
-void keyboard_handler(unsigned char ucModifiers, const unsigned char *pKeys);
 
-// Função para obter timestamp (implementação básica)
-uint32_t get_ticks(void) {
-    return tick_count++;
+// Inicialização gráfica
+void init_graphics_system(void) {
+    init_graphics();
 }
 
-// Timer callback para incrementar ticks
-void timer_handler(void) {
-    tick_count++;
+// Função auxiliar para debug (opcional)
+void debug_print_game_state(void) {
+    Position head = game.snake.body[game.snake.head];
+    printf("Snake pos: (%d,%d), Length: %d, Score: %d, State: %d\n",
+           head.x, head.y,
+           game.snake.length, game.score, game.state);
 }
 
-// Handler corrigido para teclado (assinatura correta para USPI)
-void keyboard_handler(unsigned char ucModifiers, const unsigned char *pKeys) {
-    uint32_t current_time = get_ticks();
+// Semente nova a cada boot (RNG de hardware); ela vai para a gravação, que
+// reproduz a partida no host
+void init_random(void) {
+    uint32_t seed = rng_entropy_seed();
+    printf("Semente: 0x%08x\n", seed);
+    srand(seed);
+    game_seed(&game, seed);
     
-    // Debounce de entrada
-    if ((current_time - last_input_time) > INPUT_DEBOUNCE_MS) {
-        // Verifica se alguma tecla foi pressionada
-        for (int i = 0; i < 6 && pKeys[i] != 0; i++) {
-            unsigned char key = pKeys[i];
-            
-            if (key) {
-                handle_input(key);
-                last_input_time = current_time;
-                break; // Processa apenas a primeira tecla
-            }
-        }
-    }
+    replay_recorder_init(&recorder, replay_buffer, sizeof(replay_buffer), seed);
+    game.recorder = &recorder;
 }
 
-// Inicialização gráfica
-void init_graphics_system(void) {
-    init_graphics();
-}
-
-// Verificar colisão
-bool check_collision(Position pos) {
-    // Verificar colisão com bordas
-    if (pos.x < 0 || pos.x >= GAME_WIDTH || pos.y < 0 || pos.y >= GAME_HEIGHT) {
-        return true;
-    }
+#if SMP_RENDER
+// Aplica um snapshot sem perder células de snapshots ainda não desenhados
+static void merge_snapshot(Game *dst, const Game *src) {
+    DirtyCells pending = dst->dirty;
     
-    // Verificar colisão com o corpo da cobra
-    for (int i = 1; i < game.snake.length; i++) {
-        if (game.snake.body[i].x == pos.x && game.snake.body[i].y == pos.y) {
-            return true;
-        }
+    memcpy(dst, src, sizeof(Game));
+    if (pending.full_redraw) {
+        dst->dirty.full_redraw = true;
+    }
+    for (int i = 0; i < pending.count; i++) {
+        mark_cell_dirty(&dst->dirty, pending.cells[i]);
     }
-    
-    return false;
 }
 
-// Inicializar jogo
-void init_game(void) {
-    game.snake.length = INITIAL_SNAKE_LENGTH;
-    game.snake.direction = DIR_RIGHT;
-    game.snake.next_direction = DIR_RIGHT;
-    game.score = 0;
-    game.state = GAME_RUNNING;
-    game.last_update = 0;
-    
-    // Posicionar cobra no centro
-    int start_x = GAME_WIDTH / 2;
-    int start_y = GAME_HEIGHT / 2;
+// Laço do core 1: consome todos os snapshots pendentes e desenha o último.
+// Sem printf aqui: o anel da UART só é protegido contra IRQs do core 0.
+static void render_core_main(unsigned core, void *param) {
+    (void)core;
+    (void)param;
     
-    for (int i = 0; i < game.snake.length; i++) {
-        game.snake.body[i].x = start_x - i;
-        game.snake.body[i].y = start_y;
-    }
+    profile_init_core();
     
-    spawn_food();
-}
-
-// Gerar nova comida
-void spawn_food(void) {
-    int attempts = 0;
-    do {
-        game.food.x = rand() % GAME_WIDTH;
-        game.food.y = rand() % GAME_HEIGHT;
-        attempts++;
-    } while (check_collision(game.food) && attempts < FOOD_SPAWN_RETRIES);
-}
-
-// Tratamento de entrada
-void handle_input(unsigned char key) {
-    if (game.state == GAME_OVER) {
-        switch (key) {
-            case KEY_RESTART_1:
-            case KEY_RESTART_2:
-                init_game();
-                return;
-            case KEY_QUIT_1:
-            case KEY_QUIT_2:
-                game.state = GAME_OVER; // Manter no game over ou implementar saída
-                return;
+    while (true) {
+        const Game *snapshot;
+        bool updated = false;
+        
+        while ((snapshot = spsc_peek(&snapshots)) != NULL) {
+            merge_snapshot(&render_game, snapshot);
+            spsc_release(&snapshots);
+            updated = true;
+        }
+        
+        if (updated) {
+            profile_frame_mark();
+            profile_begin(PROFILE_DRAW);
+            draw_game(&render_game);
+            profile_end(PROFILE_DRAW);
+            profile_publish();
+        } else {
+            smp_wait_event();
         }
-        return;
-    }
-    
-    switch (key) {
-        case KEY_UP_1:
-        case KEY_UP_2:
-            if (game.snake.direction != DIR_DOWN) {
-                game.snake.next_direction = DIR_UP;
-            }
-            break;
-        case KEY_DOWN_1:
-        case KEY_DOWN_2:
-            if (game.snake.direction != DIR_UP) {
-                game.snake.next_direction = DIR_DOWN;
-            }
-            break;
-        case KEY_LEFT_1:
-        case KEY_LEFT_2:
-            if (game.snake.direction != DIR_RIGHT) {
-                game.snake.next_direction = DIR_LEFT;
-            }
-            break;
-        case KEY_RIGHT_1:
-        case KEY_RIGHT_2:
-            if (game.snake.direction != DIR_LEFT) {
-                game.snake.next_direction = DIR_RIGHT;
-            }
-            break;
-        case KEY_RESTART_1:
-        case KEY_RESTART_2:
-            init_game();
-            break;
-        case KEY_QUIT_1:
-        case KEY_QUIT_2:
-            game.state = GAME_OVER;
-            break;
-        case KEY_PAUSE_1:
-        case KEY_PAUSE_2:
-            if (game.state == GAME_RUNNING) {
-                game.state = GAME_PAUSED;
-            } else if (game.state == GAME_PAUSED) {
-                game.state = GAME_RUNNING;
-            }
-            break;
     }
 }
 
-// Atualizar jogo
-void update_game(void) {
-    if (game.state != GAME_RUNNING) {
-        return;
-    }
-    
-    uint32_t current_time = get_ticks();
-    if (current_time - game.last_update < GAME_SPEED_MS) {
+// Core 0: publica o estado atual; com a fila cheia (render atrasado) as
+// células alteradas continuam acumuladas no jogo para o próximo snapshot
+static void publish_snapshot(Game *game) {
+    Game *slot = spsc_reserve(&snapshots);
+    if (!slot) {
         return;
     }
     
-    game.last_update = current_time;
+    memcpy(slot, game, sizeof(Game));
+    spsc_publish(&snapshots);
+    smp_signal_event();
     
-    // Atualizar direção
-    game.snake.direction = game.snake.next_direction;
-    
-    // Calcular nova posição da cabeça
-    Position new_head = game.snake.body[0];
+    game->dirty.count = 0;
+    game->dirty.full_redraw = false;
+}
+
+// Inicia o core de render a partir do estado já desenhado na tela
+static void start_render_core(void) {
+    render_game = game;
+    spsc_init(&snapshots, snapshot_memory, sizeof(Game), SNAPSHOT_SLOTS);
+    render_on_core1 = smp_start_core(1, render_core_main, NULL);
     
-    switch (game.snake.direction) {
-        case DIR_UP:    new_head.y--; break;
-        case DIR_DOWN:  new_head.y++; break;
-        case DIR_LEFT:  new_head.x--; break;
-        case DIR_RIGHT: new_head.x++; break;
+    if (render_on_core1) {
+        printf("Renderização no core 1\n");
+    } else {
+        printf("AVISO: core 1 não respondeu; renderizando no core 0\n");
     }
-    
-    // Verificar colisão
-    if (check_collision(new_head)) {
-        game.state = GAME_OVER;
+}
+#endif
+
+// Um frame: publicado para o core 1 ou desenhado aqui mesmo
+static void render_frame(Game *game) {
+#if SMP_RENDER
+    if (render_on_core1) {
+        publish_snapshot(game);
         return;
     }
-    
-    // Mover corpo da cobra
-    for (int i = game.snake.length - 1; i > 0; i--) {
-        game.snake.body[i] = game.snake.body[i - 1];
-    }
-    game.snake.body[0] = new_head;
-    
-    // Verificar se comeu comida
-    if (new_head.x == game.food.x && new_head.y == game.food.y) {
-        if (game.snake.length < MAX_SNAKE_LENGTH) {
-            game.snake.length++;
-        }
-        game.score += POINTS_PER_FOOD;
-        spawn_food();
-    }
+#endif
+    profile_frame_mark();
+    profile_begin(PROFILE_DRAW);
+    draw_game(game);
+    profile_end(PROFILE_DRAW);
 }
 
-// Desenhar jogo
-void draw_game(void) {
-    graphics_clear_screen(BACKGROUND_COLOR);
-    
-    // Desenhar cobra
-    for (int i = 0; i < game.snake.length; i++) {
-        uint16_t color = (i == 0) ? SNAKE_HEAD_COLOR : SNAKE_BODY_COLOR;
-        graphics_draw_game_cell(game.snake.body[i].x, game.snake.body[i].y, color);
-    }
-    
-    // Desenhar comida
-    graphics_draw_game_cell_bordered(game.food.x, game.food.y, FOOD_COLOR, COLOR_WHITE);
-    
-    // Desenhar pontuação
-    char score_text[32];
-    sprintf(score_text, "Score: %d", game.score);
-    graphics_draw_string(10, 10, score_text, TEXT_COLOR);
-    
-    // Desenhar mensagens de estado
-    if (game.state == GAME_PAUSED) {
-        graphics_draw_rect(SCREEN_WIDTH/2 - 50, SCREEN_HEIGHT/2 - 20,
-                          100, 40, PAUSE_BG_COLOR);
-        graphics_draw_string(SCREEN_WIDTH/2 - 32, SCREEN_HEIGHT/2 - 8,
-                           "PAUSED", TEXT_COLOR);
-    } else if (game.state == GAME_OVER) {
-        graphics_draw_rect(SCREEN_WIDTH/2 - 60, SCREEN_HEIGHT/2 - 30,
-                          120, 60, PAUSE_BG_COLOR);
-        graphics_draw_string(SCREEN_WIDTH/2 - 40, SCREEN_HEIGHT/2 - 16,
-                           "GAME OVER", TEXT_COLOR);
-        graphics_draw_string(SCREEN_WIDTH/2 - 48, SCREEN_HEIGHT/2,
-                           "Press R to restart", TEXT_COLOR);
-    }
+// Estatísticas do idle desde o último relatório
+static void debug_print_timer_stats(uint64_t interval_us) {
+    TimerStats stats;
+    timer_get_stats(&stats);
+    timer_reset_stats();
     
-    graphics_swap_buffers();
+    uint32_t avg = stats.wakeups ? (uint32_t)(stats.latency_total_us / stats.wakeups) : 0;
+    uint32_t idle_pct = interval_us ? (uint32_t)(stats.idle_us * 100 / interval_us) : 0;
+    printf("Idle: %u%%  despertares: %u  latência (us) min/méd/máx: %u/%u/%u\n",
+           idle_pct, stats.wakeups, stats.latency_min_us, avg, stats.latency_max_us);
 }
 
-// Função de delay - implementação robusta
-void delay_ms(unsigned int ms) {
-    // Implementação de delay básico para bare metal
-    // Ajuste o multiplicador conforme a frequência do seu sistema
-    for (unsigned int i = 0; i < ms; i++) {
-        for (volatile unsigned int j = 0; j < 1000; j++) {
-            __asm__ __volatile__("nop");
-        }
-    }
+// Console serial: ocupação do anel de TX e bytes descartados
+static void debug_print_uart_stats(void) {
+    UartStats stats;
+    uart_get_stats(&stats);
+    printf("UART: %u B escritos, pico %u/%u B, descartados %u B\n",
+           stats.bytes_written, stats.peak_used, UART_TX_BUFFER_SIZE,
+           stats.bytes_dropped);
 }
 
-// Função auxiliar para debug (opcional)
-void debug_print_game_state(void) {
-    printf("Snake pos: (%d,%d), Length: %d, Score: %d, State: %d\n",
-           game.snake.body[0].x, game.snake.body[0].y,
-           game.snake.length, game.score, game.state);
+// Uso de memória: heap, pools do malloc e arena de frame
+static void debug_print_mem_stats(const char *name, const MemStats *stats) {
+    printf("%s: em uso %u B (pico %u B) de %u B, blocos %u, fragmentação %u%%, falhas %u\n",
+           name, (unsigned)stats->in_use, (unsigned)stats->peak_in_use,
+           (unsigned)stats->size, stats->allocations,
+           stats->fragmentation_pct, stats->failed);
 }
 
-// Função para inicializar sistema de random
-void init_random(void) {
-    // Usar tick count como seed básico
-    srand(get_ticks());
+static void debug_print_memory_stats(void) {
+    MemStats stats;
+    
+    heap_get_stats(&stats);
+    debug_print_mem_stats("Heap", &stats);
+    for (unsigned i = 0; malloc_get_pool_stats(i, &stats); i++) {
+        debug_print_mem_stats("Pool", &stats);
+    }
+    render_get_frame_stats(&stats);
+    debug_print_mem_stats("Frame", &stats);
 }
 
 int main(void) {
+    // MMU e caches antes de tudo: heap, pilhas, estado do jogo e fontes
+    // passam a usar a cache
+    mmu_init();
     init_system(); 
+    
+    // Interrupções: controlador, tick periódico e comparador de despertar.
+    // Precisam estar ativas antes da USPi, que registra a IRQ do USB.
+    interrupts_init();
+    timer_init();
+    uart_enable_irq();
+    enable_interrupts();
+    profile_init();
+    
     // Inicializar USPI
     printf("Inicializando USPI...\n");
     if (!USPiInitialize()) {
@@ -299,7 +237,7 @@ int main(void) {
     
     // Inicializar jogo
     printf("Inicializando jogo...\n");
-    init_game();
+    init_game(&game);
     printf("Jogo inicializado!\n");
     
     // Aguardar dispositivos USB
@@ -324,6 +262,7 @@ int main(void) {
     }
     
     // Registrar handler de teclado com assinatura correta
+    platform_input_init();
     if (keyboard_found) {
         USPiKeyboardRegisterKeyStatusHandlerRaw(keyboard_handler);
         printf("Handler de teclado registrado!\n");
@@ -338,40 +277,90 @@ int main(void) {
     printf("================\n\n");
     
     // Desenhar tela inicial
-    draw_game();
+    draw_game(&game);
+#if SMP_RENDER
+    start_render_core();
+#endif
     
     uint32_t frame_count = 0;
     uint32_t last_debug_print = 0;
+    bool replay_dumped = false;
+    
+    // Simulação em passos fixos de GAME_SPEED_MS, frames a ~60 FPS
+    FrameClock clock;
+    frame_clock_init(&clock, get_time_us(), (uint64_t)GAME_SPEED_MS * 1000, FRAME_INTERVAL_US);
     
     // Loop principal do jogo
     while (true) {
-        uint32_t current_time = get_ticks();
+        uint64_t now = get_time_us();
+        uint32_t current_time = (uint32_t)(now / 1000);
         
-        // Processar entrada USB
-        if (USPiKeyboardAvailable()) {
-            // Não precisamos chamar USPiKeyboardUpdate() pois o handler raw é chamado automaticamente
-            // Apenas manter o sistema USB ativo
+        // Simular os passos vencidos; as teclas chegadas até cada passo são
+        // entregues logo antes dele
+        for (uint32_t steps = frame_clock_steps(&clock, now); steps > 0; steps--) {
+            profile_begin(PROFILE_INPUT);
+            platform_poll_input(&game);
+            profile_end(PROFILE_INPUT);
+            
+            profile_begin(PROFILE_UPDATE);
+            game_step(&game);
+            profile_end(PROFILE_UPDATE);
         }
         
-        // Atualizar lógica do jogo
-        update_game();
+        // Fim de partida: despejar a sessão gravada até aqui para reprodução no
+        // host. O marcador de fim é removido em seguida para a gravação seguir
+        // após um reinício. O despejo passa de longe do anel da UART: com a
+        // política padrão (descartar) ele chegaria cortado, então bloqueia
+        // até a FIFO dar vazão.
+        if (game.state == GAME_OVER && !replay_dumped) {
+            ReplayRecorder saved = recorder;
+            replay_record_end(&recorder, game.steps);
+            
+            UartStats uart_before;
+            UartStats uart_after;
+            uart_get_stats(&uart_before);
+            uart_set_overflow_policy(UART_OVERFLOW_BLOCK);
+            if (recorder.overflow) {
+                printf("AVISO: gravação truncada (%d bytes)\n", REPLAY_BUFFER_SIZE);
+            }
+            DebugHexdump(replay_buffer, recorder.size, "replay");
+            uart_set_overflow_policy(UART_OVERFLOW_DROP);
+            
+            uart_get_stats(&uart_after);
+            if (uart_after.bytes_dropped != uart_before.bytes_dropped) {
+                printf("AVISO: despejo truncado, %u B descartados pela UART\n",
+                       uart_after.bytes_dropped - uart_before.bytes_dropped);
+            }
+            recorder = saved;
+            replay_dumped = true;
+        } else if (game.state != GAME_OVER) {
+            replay_dumped = false;
+        }
         
-        // Renderizar
-        draw_game();
+        // Renderizar na cadência própria, independente da simulação
+        if (frame_clock_render_due(&clock, now)) {
+            render_frame(&game);
+            frame_count++;
+        }
         
         // Debug info a cada 5 segundos (opcional)
         if (current_time - last_debug_print > 5000) {
             debug_print_game_state();
+            debug_print_timer_stats((uint64_t)(current_time - last_debug_print) * 1000);
+            debug_print_memory_stats();
+            debug_print_uart_stats();
+            profile_report();
+            if (clock.dropped_steps) {
+                printf("Passos descartados: %u\n", clock.dropped_steps);
+            }
             last_debug_print = current_time;
         }
         
-        // Controle de FPS (~60 FPS)
-        delay_ms(16);
-        frame_count++;
-        
-        // Verificar se deve sair (implementar lógica de saída se necessário)
-        // Por enquanto, loop infinito - o jogo roda continuamente
-        ProcessKernelTimers();
+        // Dormir (WFI) até o próximo passo ou frame; os timers do kernel
+        // rodam no tick periódico. Antes, completar a FIFO da UART para não
+        // depender só da IRQ de TX.
+        uart_poll();
+        sleep_until_us(frame_clock_next_deadline(&clock));
     }
     
     // Cleanup (nunca alcançado neste exemplo)
@@ -0,0 +1,273 @@
+//
+// memops.c - memcpy/memmove/memset/memcmp otimizados (bare metal)
+//
+// Compilado com -fno-tree-loop-distribute-patterns: sem isso o GCC pode
+// reconhecer os laços de bytes abaixo e trocá-los por chamadas a estas
+// mesmas funções.
+//
+// Sem MMU toda a RAM é memória Device, onde acesso desalinhado gera falta:
+// todo acesso largo aqui é alinhado ao próprio tamanho. Quando origem e
+// destino não têm o mesmo alinhamento, a cópia lê palavras alinhadas da
+// origem e as recombina com deslocamentos.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Acessos largos sem violar strict aliasing
+typedef uint32_t __attribute__((may_alias)) word_t;
+typedef uint64_t __attribute__((may_alias)) dword_t;
+
+// Abaixo disso o laço de bytes é mais barato que alinhar
+#define SMALL_COPY      16
+
+// A partir daqui compensa usar registradores de 128 bits
+#define NEON_THRESHOLD  64
+
+// ================================
+// CÓPIA PARA FRENTE
+// ================================
+
+// Também usada por memmove quando o destino está antes da origem: cada
+// bloco é lido por inteiro antes de ser escrito
+static void copy_forward(uint8_t *d, const uint8_t *s, size_t n) {
+    if (n >= SMALL_COPY) {
+        // Cabeça: alinhar o destino em 8
+        while ((uintptr_t)d & 7) {
+            *d++ = *s++;
+            n--;
+        }
+
+        if (((uintptr_t)s & 7) == 0) {
+#if defined(__ARM_NEON)
+            while (n >= NEON_THRESHOLD) {
+                uint8x16_t a = vld1q_u8(s);
+                uint8x16_t b = vld1q_u8(s + 16);
+                uint8x16_t c = vld1q_u8(s + 32);
+                uint8x16_t e = vld1q_u8(s + 48);
+                vst1q_u8(d, a);
+                vst1q_u8(d + 16, b);
+                vst1q_u8(d + 32, c);
+                vst1q_u8(d + 48, e);
+                d += 64;
+                s += 64;
+                n -= 64;
+            }
+#endif
+            while (n >= 32) {
+                uint64_t a = ((const dword_t *)s)[0];
+                uint64_t b = ((const dword_t *)s)[1];
+                uint64_t c = ((const dword_t *)s)[2];
+                uint64_t e = ((const dword_t *)s)[3];
+                ((dword_t *)d)[0] = a;
+                ((dword_t *)d)[1] = b;
+                ((dword_t *)d)[2] = c;
+                ((dword_t *)d)[3] = e;
+                d += 32;
+                s += 32;
+                n -= 32;
+            }
+            while (n >= 8) {
+                *(dword_t *)d = *(const dword_t *)s;
+                d += 8;
+                s += 8;
+                n -= 8;
+            }
+        } else if (((uintptr_t)s & 3) == 0) {
+            while (n >= 4) {
+                *(word_t *)d = *(const word_t *)s;
+                d += 4;
+                s += 4;
+                n -= 4;
+            }
+        } else {
+            // Origem desalinhada: palavras alinhadas recombinadas
+            // (little endian). A última leitura não passa da palavra que
+            // contém o último byte da origem.
+            unsigned shift = ((uintptr_t)s & 3) * 8;
+            const word_t *sw = (const word_t *)((uintptr_t)s & ~(uintptr_t)3);
+            uint32_t current = *sw++;
+
+            while (n >= 8) {
+                uint32_t next = *sw++;
+                *(word_t *)d = (current >> shift) | (next << (32 - shift));
+                current = next;
+                d += 4;
+                s += 4;
+                n -= 4;
+            }
+        }
+    }
+
+    // Cauda
+    while (n--) {
+        *d++ = *s++;
+    }
+}
+
+// ================================
+// CÓPIA PARA TRÁS (memmove com sobreposição)
+// ================================
+
+static void copy_backward(uint8_t *d, const uint8_t *s, size_t n) {
+    d += n;
+    s += n;
+
+    if (n >= SMALL_COPY) {
+        // Alinhar o fim do destino em 8
+        while ((uintptr_t)d & 7) {
+            *--d = *--s;
+            n--;
+        }
+
+        if (((uintptr_t)s & 7) == 0) {
+#if defined(__ARM_NEON)
+            while (n >= NEON_THRESHOLD) {
+                d -= 64;
+                s -= 64;
+                n -= 64;
+                uint8x16_t a = vld1q_u8(s + 48);
+                uint8x16_t b = vld1q_u8(s + 32);
+                uint8x16_t c = vld1q_u8(s + 16);
+                uint8x16_t e = vld1q_u8(s);
+                vst1q_u8(d + 48, a);
+                vst1q_u8(d + 32, b);
+                vst1q_u8(d + 16, c);
+                vst1q_u8(d, e);
+            }
+#endif
+            while (n >= 8) {
+                d -= 8;
+                s -= 8;
+                n -= 8;
+                *(dword_t *)d = *(const dword_t *)s;
+            }
+        } else if (((uintptr_t)s & 3) == 0) {
+            while (n >= 4) {
+                d -= 4;
+                s -= 4;
+                n -= 4;
+                *(word_t *)d = *(const word_t *)s;
+            }
+        }
+    }
+
+    while (n--) {
+        *--d = *--s;
+    }
+}
+
+// ================================
+// API
+// ================================
+
+void* memcpy(void* dest, const void* src, size_t n) {
+    copy_forward((uint8_t *)dest, (const uint8_t *)src, n);
+    return dest;
+}
+
+void* memmove(void* dest, const void* src, size_t n) {
+    uint8_t *d = (uint8_t *)dest;
+    const uint8_t *s = (const uint8_t *)src;
+
+    if (d == s || n == 0) {
+        return dest;
+    }
+
+    // Destino depois da origem e sobreposto: copiar de trás para frente
+    if (d > s && d < s + n) {
+        copy_backward(d, s, n);
+    } else {
+        copy_forward(d, s, n);
+    }
+    return dest;
+}
+
+void* memset(void* s, int c, size_t n) {
+    uint8_t *d = (uint8_t *)s;
+    uint8_t byte = (uint8_t)c;
+
+    if (n >= SMALL_COPY) {
+        while ((uintptr_t)d & 7) {
+            *d++ = byte;
+            n--;
+        }
+
+#if defined(__ARM_NEON)
+        if (n >= NEON_THRESHOLD) {
+            uint8x16_t v = vdupq_n_u8(byte);
+
+            // Stores de 128 bits a partir de 16 bytes alinhados
+            if ((uintptr_t)d & 8) {
+                *(dword_t *)d = 0x0101010101010101ull * byte;
+                d += 8;
+                n -= 8;
+            }
+            while (n >= 64) {
+                vst1q_u8(d, v);
+                vst1q_u8(d + 16, v);
+                vst1q_u8(d + 32, v);
+                vst1q_u8(d + 48, v);
+                d += 64;
+                n -= 64;
+            }
+        }
+#endif
+
+        uint64_t pattern = 0x0101010101010101ull * byte;
+        while (n >= 32) {
+            ((dword_t *)d)[0] = pattern;
+            ((dword_t *)d)[1] = pattern;
+            ((dword_t *)d)[2] = pattern;
+            ((dword_t *)d)[3] = pattern;
+            d += 32;
+            n -= 32;
+        }
+        while (n >= 8) {
+            *(dword_t *)d = pattern;
+            d += 8;
+            n -= 8;
+        }
+    }
+
+    while (n--) {
+        *d++ = byte;
+    }
+    return s;
+}
+
+int memcmp(const void* s1, const void* s2, size_t n) {
+    const uint8_t *p1 = (const uint8_t *)s1;
+    const uint8_t *p2 = (const uint8_t *)s2;
+
+    // Palavras de 64 bits quando os dois lados se alinham juntos; a
+    // primeira palavra diferente é resolvida byte a byte abaixo
+    if (n >= SMALL_COPY && (((uintptr_t)p1 ^ (uintptr_t)p2) & 7) == 0) {
+        while ((uintptr_t)p1 & 7) {
+            if (*p1 != *p2) {
+                return *p1 - *p2;
+            }
+            p1++;
+            p2++;
+            n--;
+        }
+        while (n >= 8 && *(const dword_t *)p1 == *(const dword_t *)p2) {
+            p1 += 8;
+            p2 += 8;
+            n -= 8;
+        }
+    }
+
+    while (n--) {
+        if (*p1 != *p2) {
+            return *p1 - *p2;
+        }
+        p1++;
+        p2++;
+    }
+    return 0;
+}
@@ -0,0 +1,262 @@
+//
+// mmu.c - Tabelas de tradução em mapeamento identidade e manutenção de cache
+//
+
+#include "mmu.h"
+#include "mailbox.h"
+
+// Limites físicos do BCM2837
+#define PERIPHERAL_BASE     0x3F000000
+#define LOCAL_END           0x40100000
+
+// Divisão ARM/GPU de gpu_mem=64 (config.txt), se o mailbox não responder
+#define DEFAULT_ARM_MEMORY  0x3C000000
+
+#define TAG_GET_ARM_MEMORY  0x00010005
+
+typedef enum {
+    MEMORY_UNMAPPED,
+    MEMORY_NORMAL_WB,       // RAM do ARM
+    MEMORY_NORMAL_NC,       // RAM da GPU (framebuffer)
+    MEMORY_DEVICE           // Periféricos
+} MemoryType;
+
+static MemoryType memory_type(uint32_t base, uint32_t arm_memory_end) {
+    if (base < arm_memory_end) {
+        return MEMORY_NORMAL_WB;
+    } else if (base < PERIPHERAL_BASE) {
+        return MEMORY_NORMAL_NC;
+    } else if (base < LOCAL_END) {
+        return MEMORY_DEVICE;
+    }
+    return MEMORY_UNMAPPED;
+}
+
+#if defined(__aarch64__)
+// Granule de 4 KiB e endereços de 32 bits (T0SZ = 32): o passeio começa no
+// nível 1 (4 entradas de 1 GiB); os dois primeiros GiB descem para tabelas
+// de nível 2 com blocos de 2 MiB.
+#define BLOCK_SHIFT         21
+#define L2_ENTRIES          512
+#define L2_TABLES           2
+
+// Descritores (formato longo)
+#define DESC_BLOCK          1
+#define DESC_TABLE          3
+#define DESC_ATTR(index)    ((uint64_t)(index) << 2)
+#define DESC_SH_INNER       (3 << 8)
+#define DESC_AF             (1 << 10)
+#define DESC_PXN            (1ull << 53)
+#define DESC_UXN            (1ull << 54)
+
+// MAIR_EL1: 0 = device nGnRnE, 1 = normal WBWA, 2 = normal sem cache
+#define MAIR_VALUE          ((0x00ull << 0) | (0xFFull << 8) | (0x44ull << 16))
+
+#define ATTR_NORMAL_WB      (DESC_ATTR(1) | DESC_SH_INNER)
+#define ATTR_NORMAL_NC      (DESC_ATTR(2) | DESC_SH_INNER)
+#define ATTR_DEVICE         (DESC_ATTR(0) | DESC_PXN | DESC_UXN)
+
+// TCR_EL1: só TTBR0 (EPD1), passeio WBWA compartilhável, IPS de 32 bits
+#define TCR_T0SZ            32
+#define TCR_IRGN0_WBWA      (1 << 8)
+#define TCR_ORGN0_WBWA      (1 << 10)
+#define TCR_SH0_INNER       (3 << 12)
+#define TCR_EPD1            (1 << 23)
+#define TCR_VALUE           (TCR_T0SZ | TCR_IRGN0_WBWA | TCR_ORGN0_WBWA | \
+                             TCR_SH0_INNER | TCR_EPD1)
+
+#define SCTLR_M             (1 << 0)
+#define SCTLR_C             (1 << 2)
+#define SCTLR_I             (1 << 12)
+
+static uint64_t level1[4] __attribute__((aligned(4096)));
+static uint64_t level2[L2_TABLES][L2_ENTRIES] __attribute__((aligned(4096)));
+
+static void build_table(uint32_t arm_memory_end) {
+    for (int t = 0; t < L2_TABLES; t++) {
+        for (int i = 0; i < L2_ENTRIES; i++) {
+            uint32_t base = ((uint32_t)(t * L2_ENTRIES + i)) << BLOCK_SHIFT;
+            uint64_t attrs;
+            
+            switch (memory_type(base, arm_memory_end)) {
+                case MEMORY_NORMAL_WB: attrs = ATTR_NORMAL_WB; break;
+                case MEMORY_NORMAL_NC: attrs = ATTR_NORMAL_NC; break;
+                case MEMORY_DEVICE:    attrs = ATTR_DEVICE; break;
+                default:
+                    level2[t][i] = 0;
+                    continue;
+            }
+            level2[t][i] = base | DESC_BLOCK | DESC_AF | attrs;
+        }
+        level1[t] = (uintptr_t)level2[t] | DESC_TABLE;
+    }
+    for (int t = L2_TABLES; t < 4; t++) {
+        level1[t] = 0;
+    }
+}
+
+// Blocos de 2 MiB: o topo da RAM do ARM é arredondado para baixo
+#define MAPPING_GRANULE     (1u << BLOCK_SHIFT)
+
+void mmu_enable(void) {
+    uint64_t sctlr;
+    
+    __asm__ volatile(
+        "msr mair_el1, %0\n\t"
+        "msr tcr_el1, %1\n\t"
+        "msr ttbr0_el1, %2\n\t"
+        "tlbi vmalle1\n\t"
+        "ic iallu\n\t"
+        "dsb sy\n\t"
+        "isb"
+        :: "r"(MAIR_VALUE), "r"((uint64_t)TCR_VALUE), "r"((uintptr_t)level1) : "memory");
+    
+    __asm__ volatile("mrs %0, sctlr_el1" : "=r"(sctlr));
+    sctlr |= SCTLR_M | SCTLR_C | SCTLR_I;
+    __asm__ volatile(
+        "msr sctlr_el1, %0\n\t"
+        "isb"
+        :: "r"(sctlr) : "memory");
+}
+
+bool mmu_enabled(void) {
+    uint64_t sctlr;
+    __asm__ volatile("mrs %0, sctlr_el1" : "=r"(sctlr));
+    return sctlr & SCTLR_M;
+}
+
+// Limpeza/invalidação por VA até o ponto de coerência
+#define DCACHE_CLEAN            "dc cvac, %0"
+#define DCACHE_INVALIDATE       "dc ivac, %0"
+#define DCACHE_CLEAN_INVALIDATE "dc civac, %0"
+#else
+#define SECTION_SHIFT       20
+#define SECTION_COUNT       4096
+
+// Descritor de seção (formato curto, TEX remap desligado)
+#define SECTION             (1 << 1)
+#define SECTION_B           (1 << 2)
+#define SECTION_C           (1 << 3)
+#define SECTION_XN          (1 << 4)
+#define SECTION_AP_RW       (3 << 10)   // Leitura/escrita em todos os modos
+#define SECTION_TEX(x)      ((x) << 12)
+#define SECTION_S           (1 << 16)
+
+// Tipos de memória usados no mapa
+#define ATTR_NORMAL_WB      (SECTION_TEX(1) | SECTION_C | SECTION_B | SECTION_S)
+#define ATTR_NORMAL_NC      (SECTION_TEX(1) | SECTION_S)
+#define ATTR_DEVICE         (SECTION_B | SECTION_XN)
+
+// TTBR0: passeio da tabela pela cache (interna e externa write-back
+// write-allocate), compartilhável
+#define TTBR_IRGN_WBWA      (1 << 6)
+#define TTBR_RGN_WBWA       (1 << 3)
+#define TTBR_S              (1 << 1)
+
+#define SCTLR_M             (1 << 0)
+#define SCTLR_C             (1 << 2)
+#define SCTLR_Z             (1 << 11)
+#define SCTLR_I             (1 << 12)
+
+static uint32_t translation_table[SECTION_COUNT] __attribute__((aligned(16384)));
+
+static void build_table(uint32_t arm_memory_end) {
+    for (uint32_t i = 0; i < SECTION_COUNT; i++) {
+        uint32_t base = i << SECTION_SHIFT;
+        uint32_t attrs;
+        
+        switch (memory_type(base, arm_memory_end)) {
+            case MEMORY_NORMAL_WB: attrs = ATTR_NORMAL_WB; break;
+            case MEMORY_NORMAL_NC: attrs = ATTR_NORMAL_NC; break;
+            case MEMORY_DEVICE:    attrs = ATTR_DEVICE; break;
+            default:
+                translation_table[i] = 0;
+                continue;
+        }
+        translation_table[i] = base | SECTION | SECTION_AP_RW | attrs;
+    }
+}
+
+// Seções de 1 MiB: uma seção parcial no topo da RAM do ARM fica sem cache
+#define MAPPING_GRANULE     (1u << SECTION_SHIFT)
+
+void mmu_enable(void) {
+    uint32_t ttbr = (uint32_t)(uintptr_t)translation_table |
+                    TTBR_IRGN_WBWA | TTBR_RGN_WBWA | TTBR_S;
+    uint32_t sctlr;
+    
+    __asm__ volatile(
+        "mcr p15, 0, %0, c2, c0, 2\n\t"     // TTBCR = 0: só TTBR0, 4 GiB
+        "mcr p15, 0, %1, c2, c0, 0\n\t"     // TTBR0
+        "mcr p15, 0, %2, c3, c0, 0\n\t"     // DACR: domínio 0 cliente
+        "mcr p15, 0, %0, c8, c7, 0\n\t"     // TLBIALL
+        "mcr p15, 0, %0, c7, c5, 0\n\t"     // ICIALLU
+        "mcr p15, 0, %0, c7, c5, 6\n\t"     // BPIALL
+        "dsb sy\n\t"
+        "isb"
+        :: "r"(0), "r"(ttbr), "r"(1) : "memory");
+    
+    __asm__ volatile("mrc p15, 0, %0, c1, c0, 0" : "=r"(sctlr));
+    sctlr |= SCTLR_M | SCTLR_C | SCTLR_Z | SCTLR_I;
+    __asm__ volatile(
+        "mcr p15, 0, %0, c1, c0, 0\n\t"
+        "isb"
+        :: "r"(sctlr) : "memory");
+}
+
+bool mmu_enabled(void) {
+    uint32_t sctlr;
+    __asm__ volatile("mrc p15, 0, %0, c1, c0, 0" : "=r"(sctlr));
+    return sctlr & SCTLR_M;
+}
+
+// Operações por MVA até o ponto de coerência
+#define DCACHE_CLEAN            "mcr p15, 0, %0, c7, c10, 1"    // DCCMVAC
+#define DCACHE_INVALIDATE       "mcr p15, 0, %0, c7, c6, 1"     // DCIMVAC
+#define DCACHE_CLEAN_INVALIDATE "mcr p15, 0, %0, c7, c14, 1"    // DCCIMVAC
+#endif
+
+// Topo da RAM do ARM; acima dela, até os periféricos, fica a RAM da GPU
+static uint32_t query_arm_memory_end(void) {
+    static volatile uint32_t MAILBOX_ALIGN mbox[16];   // Uma linha de cache inteira
+    
+    mbox[0] = 8 * sizeof(uint32_t);
+    mbox[1] = MAILBOX_REQUEST;
+    mbox[2] = TAG_GET_ARM_MEMORY;
+    mbox[3] = 8;
+    mbox[4] = 0;
+    mbox[5] = 0;        // Base
+    mbox[6] = 0;        // Tamanho
+    mbox[7] = TAG_END;
+    
+    if (!mailbox_call(MAILBOX_CHANNEL_PROPERTY, mbox) || mbox[5] != 0 ||
+        mbox[6] == 0 || mbox[6] > PERIPHERAL_BASE) {
+        return DEFAULT_ARM_MEMORY;
+    }
+    return mbox[6];
+}
+
+void mmu_init(void) {
+    build_table(query_arm_memory_end() & ~(MAPPING_GRANULE - 1));
+    
+    // Tabela escrita com a MMU desligada: já está na memória
+    __asm__ volatile("dsb sy" ::: "memory");
+    mmu_enable();
+}
+
+// Visível à GPU e ao DMA (ponto de coerência)
+#define DCACHE_RANGE_OP(name, insn, qualifier)                                  \
+void name(qualifier volatile void *start, size_t size) {                        \
+    uintptr_t line = (uintptr_t)start & ~(uintptr_t)(CACHE_LINE_SIZE - 1);      \
+    uintptr_t end = (uintptr_t)start + size;                                    \
+                                                                                \
+    __asm__ volatile("dsb sy" ::: "memory");                                    \
+    for (; line < end; line += CACHE_LINE_SIZE) {                               \
+        __asm__ volatile(insn :: "r"(line) : "memory");                         \
+    }                                                                           \
+    __asm__ volatile("dsb sy" ::: "memory");                                    \
+}
+
+DCACHE_RANGE_OP(dcache_clean_range, DCACHE_CLEAN, const)
+DCACHE_RANGE_OP(dcache_invalidate_range, DCACHE_INVALIDATE, )
+DCACHE_RANGE_OP(dcache_clean_invalidate_range, DCACHE_CLEAN_INVALIDATE, const)
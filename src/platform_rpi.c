@@ -0,0 +1,52 @@
+//
+// platform_rpi.c - Camada de plataforma para o Raspberry Pi (bare metal + USPI)
+//
+
+#include "game.h"
+#include "input.h"
+#include "platform.h"
+#include "timer.h"
+
+// Eventos de teclado produzidos no handler da USPi (contexto de IRQ) e
+// entregues ao jogo pelo laço principal: o estado do jogo só é alterado
+// fora da interrupção.
+static InputQueue input;
+
+void keyboard_handler(unsigned char ucModifiers, const unsigned char *pKeys);
+
+uint64_t get_time_us(void) {
+    return get_system_timer();
+}
+
+// Milissegundos desde o boot
+uint32_t get_ticks(void) {
+    return (uint32_t)(get_system_timer() / 1000);
+}
+
+void platform_input_init(void) {
+    input_init(&input);
+}
+
+// Handler de relatório cru da USPi: todas as teclas do relatório viram
+// eventos, sem descartar nada por debounce
+void keyboard_handler(unsigned char ucModifiers, const unsigned char *pKeys) {
+    input_report(&input, ucModifiers, pKeys, get_system_timer());
+}
+
+void platform_poll_input(Game *game) {
+    InputEvent event;
+    while (input_next_event(&input, &event)) {
+        if (event.pressed) {
+            handle_input(game, event.key);
+        }
+    }
+}
+
+// Dorme em WFI até o prazo (comparador C1 do system timer)
+void sleep_until_us(uint64_t deadline) {
+    timer_sleep_until(deadline);
+}
+
+void delay_ms(unsigned int ms) {
+    sleep_until_us(get_system_timer() + (uint64_t)ms * 1000);
+}
@@ -0,0 +1,137 @@
+//
+// pool.c - Pools de blocos de tamanho fixo (lista livre com CAS)
+//
+
+#include "pool.h"
+
+#define INDEX_MASK  0xFFFFu
+#define TAG_SHIFT   16
+
+#if (defined(__arm__) || defined(__aarch64__)) && !defined(__linux__)
+#include "interrupts.h"
+
+// Bare metal: os pools só são usados pelo core 0, então mascarar IRQ já
+// torna a troca atômica em relação aos handlers, sem depender do monitor
+// exclusivo.
+static bool compare_and_swap(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    uint32_t flags = irq_save();
+    bool swapped = *ptr == expected;
+    if (swapped) {
+        *ptr = desired;
+    }
+    irq_restore(flags);
+    return swapped;
+}
+#else
+static bool compare_and_swap(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+static void atomic_add(volatile uint32_t *ptr, int32_t delta) {
+    uint32_t old;
+    do {
+        old = *ptr;
+    } while (!compare_and_swap(ptr, old, old + delta));
+}
+
+// Próximo índice livre, guardado no início do próprio bloco livre
+static inline volatile uint32_t *block_link(Pool *pool, uint32_t index) {
+    return (volatile uint32_t *)(pool->base + (size_t)index * pool->block_size);
+}
+
+bool pool_init(Pool *pool, void *memory, size_t block_size, uint32_t count) {
+    if (!memory || count == 0 || count > POOL_MAX_BLOCKS) {
+        return false;
+    }
+    
+    if (block_size < sizeof(uint32_t)) {
+        block_size = sizeof(uint32_t);
+    }
+    pool->base = memory;
+    pool->block_size = (uint32_t)((block_size + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1));
+    pool->count = count;
+    pool->in_use = 0;
+    pool->peak = 0;
+    pool->failed = 0;
+    
+    // Encadear todos os blocos em ordem; o último aponta para "vazio"
+    for (uint32_t i = 0; i < count; i++) {
+        *block_link(pool, i) = i + 1 < count ? i + 2 : 0;
+    }
+    pool->head = 1;
+    return true;
+}
+
+void *pool_alloc(Pool *pool) {
+    uint32_t old_head;
+    uint32_t index;
+    
+    do {
+        old_head = pool->head;
+        index = old_head & INDEX_MASK;
+        if (index == 0) {
+            atomic_add(&pool->failed, 1);
+            return NULL;
+        }
+        
+        // Se outro contexto tirou este bloco antes do CAS, o tag mudou e
+        // o valor lido aqui é descartado
+        uint32_t next = *block_link(pool, index - 1);
+        uint32_t new_head = ((old_head >> TAG_SHIFT) + 1) << TAG_SHIFT | (next & INDEX_MASK);
+        if (compare_and_swap(&pool->head, old_head, new_head)) {
+            break;
+        }
+    } while (true);
+    
+    atomic_add(&pool->in_use, 1);
+    uint32_t used = pool->in_use;
+    uint32_t peak;
+    do {
+        peak = pool->peak;
+    } while (used > peak && !compare_and_swap(&pool->peak, peak, used));
+    
+    return pool->base + (size_t)(index - 1) * pool->block_size;
+}
+
+void pool_free(Pool *pool, void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    
+    uint32_t index = (uint32_t)(((uint8_t *)ptr - pool->base) / pool->block_size);
+    uint32_t old_head;
+    
+    do {
+        old_head = pool->head;
+        *block_link(pool, index) = old_head & INDEX_MASK;
+        uint32_t new_head = ((old_head >> TAG_SHIFT) + 1) << TAG_SHIFT | (index + 1);
+        if (compare_and_swap(&pool->head, old_head, new_head)) {
+            break;
+        }
+    } while (true);
+    
+    atomic_add(&pool->in_use, -1);
+}
+
+bool pool_owns(const Pool *pool, const void *ptr) {
+    const uint8_t *p = ptr;
+    return pool->base && p >= pool->base &&
+           p < pool->base + (size_t)pool->count * pool->block_size;
+}
+
+void pool_get_stats(const Pool *pool, MemStats *stats) {
+    uint32_t used = pool->in_use;
+    uint32_t free_count = pool->count - used;
+    
+    stats->size = (size_t)pool->count * pool->block_size;
+    stats->in_use = (size_t)used * pool->block_size;
+    stats->peak_in_use = (size_t)pool->peak * pool->block_size;
+    stats->free_bytes = (size_t)free_count * pool->block_size;
+    stats->largest_free = free_count ? pool->block_size : 0;
+    stats->allocations = used;
+    stats->free_blocks = free_count;
+    stats->failed = pool->failed;
+    stats->fragmentation_pct = 0;   // Blocos iguais: nunca fragmenta
+}
@@ -0,0 +1,347 @@
+//
+// profile.c - Profiler de zonas (PMU do Cortex-A53 no Pi, clock_gettime no host)
+//
+
+#include <stdio.h>
+#include "profile.h"
+
+// Contadores crus de uma medição
+typedef struct {
+    uint32_t ticks;
+    uint32_t cache_misses;
+    uint32_t instructions;
+} ProfileCounters;
+
+#if (defined(__arm__) || defined(__aarch64__)) && !defined(__linux__)
+#include "interrupts.h"
+#include "smp.h"
+#include "spsc.h"
+#include "timer.h"
+
+// Eventos da PMU (ARMv8, comuns ao AArch32)
+#define PMU_EVENT_L1D_REFILL    0x03
+#define PMU_EVENT_INST_RETIRED  0x08
+
+#define PMCR_ENABLE             (1 << 0)
+#define PMCR_RESET_EVENTS       (1 << 1)
+#define PMCR_RESET_CYCLES       (1 << 2)
+#define PMCNTEN_CYCLES          (1u << 31)
+
+// Janela de calibração do contador de ciclos contra o system timer
+#define CALIBRATION_US          1000
+
+static uint32_t ticks_per_us = 1;
+
+#if defined(__aarch64__)
+// Os mesmos contadores pelos registradores de sistema do AArch64
+static inline uint32_t pmu_read_cycles(void) {
+    uint64_t value;
+    __asm__ volatile("mrs %0, pmccntr_el0" : "=r"(value));
+    return (uint32_t)value;
+}
+
+static inline uint32_t pmu_read_event(uint32_t counter) {
+    uint64_t value;
+    __asm__ volatile("msr pmselr_el0, %0" :: "r"((uint64_t)counter));
+    __asm__ volatile("isb");
+    __asm__ volatile("mrs %0, pmxevcntr_el0" : "=r"(value));
+    return (uint32_t)value;
+}
+
+static void pmu_set_event(uint32_t counter, uint32_t event) {
+    __asm__ volatile("msr pmselr_el0, %0" :: "r"((uint64_t)counter));
+    __asm__ volatile("isb");
+    __asm__ volatile("msr pmxevtyper_el0, %0" :: "r"((uint64_t)event));
+}
+
+static void pmu_enable(uint32_t pmcr, uint32_t counters) {
+    __asm__ volatile("msr pmcr_el0, %0" :: "r"((uint64_t)pmcr));
+    __asm__ volatile("msr pmcntenset_el0, %0" :: "r"((uint64_t)counters));
+    __asm__ volatile("isb");
+}
+#else
+static inline uint32_t pmu_read_cycles(void) {
+    uint32_t value;
+    __asm__ volatile("mrc p15, 0, %0, c9, c13, 0" : "=r"(value));
+    return value;
+}
+
+static inline uint32_t pmu_read_event(uint32_t counter) {
+    uint32_t value;
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 5" :: "r"(counter));
+    __asm__ volatile("isb");
+    __asm__ volatile("mrc p15, 0, %0, c9, c13, 2" : "=r"(value));
+    return value;
+}
+
+static void pmu_set_event(uint32_t counter, uint32_t event) {
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 5" :: "r"(counter));
+    __asm__ volatile("isb");
+    __asm__ volatile("mcr p15, 0, %0, c9, c13, 1" :: "r"(event));
+}
+
+static void pmu_enable(uint32_t pmcr, uint32_t counters) {
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 0" :: "r"(pmcr));
+    __asm__ volatile("mcr p15, 0, %0, c9, c12, 1" :: "r"(counters));
+    __asm__ volatile("isb");
+}
+#endif
+
+// Seleção + leitura não podem ser intercaladas por uma medição em IRQ
+static void read_counters(ProfileCounters *counters) {
+    uint32_t flags = irq_save();
+    counters->ticks = pmu_read_cycles();
+    counters->cache_misses = pmu_read_event(0);
+    counters->instructions = pmu_read_event(1);
+    irq_restore(flags);
+}
+
+static void counters_init(void) {
+    pmu_set_event(0, PMU_EVENT_L1D_REFILL);
+    pmu_set_event(1, PMU_EVENT_INST_RETIRED);
+    
+    pmu_enable(PMCR_ENABLE | PMCR_RESET_EVENTS | PMCR_RESET_CYCLES, PMCNTEN_CYCLES | 0x3);
+    
+    // Frequência real do core (depende do config.txt e do firmware)
+    uint64_t start = get_system_timer();
+    uint32_t cycles = pmu_read_cycles();
+    while (get_system_timer() - start < CALIBRATION_US) {
+    }
+    uint32_t elapsed = (uint32_t)(get_system_timer() - start);
+    ticks_per_us = (pmu_read_cycles() - cycles) / elapsed;
+    if (ticks_per_us == 0) {
+        ticks_per_us = 1;
+    }
+}
+
+// A zona de timers é medida em IRQ: o anel é atualizado com IRQ mascarada
+#define PROFILE_LOCK()      uint32_t profile_flags = irq_save()
+#define PROFILE_UNLOCK()    irq_restore(profile_flags)
+
+// Cada core mede nas próprias zonas (a PMU também é por core)
+#define PROFILE_CORES       SMP_CORES
+#define PROFILE_CORE()      smp_core_id()
+#else
+#include <time.h>
+
+// Host: nanossegundos de relógio monotônico, sem contadores de eventos
+static const uint32_t ticks_per_us = 1000;
+
+static void read_counters(ProfileCounters *counters) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    counters->ticks = (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+    counters->cache_misses = 0;
+    counters->instructions = 0;
+}
+
+static void counters_init(void) {
+}
+
+#define PROFILE_LOCK()
+#define PROFILE_UNLOCK()
+
+#define PROFILE_CORES       1
+#define PROFILE_CORE()      0
+#endif
+
+typedef struct {
+    ProfileCounters start;
+    ProfileCounters history[PROFILE_HISTORY];
+    uint32_t next;          // Próxima posição no anel
+    uint32_t count;         // Amostras válidas
+} ZoneData;
+
+static const char *const zone_names[PROFILE_ZONE_COUNT] = {
+    "input", "update", "draw", "timers", "frame"
+};
+
+// Só o próprio core escreve na sua linha; os outros nunca a leem
+typedef struct {
+    ZoneData zones[PROFILE_ZONE_COUNT];
+    bool frame_marked;
+} CoreProfile;
+
+static CoreProfile cores[PROFILE_CORES];
+
+#if PROFILE_CORES > 1
+// Estatísticas de um core secundário, calculadas por ele mesmo e entregues
+// ao core 0 por uma fila SPSC: o core 0 nunca lê um anel sendo escrito
+typedef struct {
+    ProfileStats zones[PROFILE_ZONE_COUNT];
+} ProfileSnapshot;
+
+#define SNAPSHOT_SLOTS      2
+
+static uint8_t snapshot_memory[PROFILE_CORES][SPSC_REGION_SIZE(sizeof(ProfileSnapshot), SNAPSHOT_SLOTS)]
+    __attribute__((aligned(SPSC_ALIGN)));
+static SpscQueue snapshot_queues[PROFILE_CORES];
+static ProfileSnapshot received[PROFILE_CORES];    // Última recebida (core 0)
+#endif
+
+static void push_sample(ZoneData *zone, const ProfileCounters *now) {
+    PROFILE_LOCK();
+    ProfileCounters *sample = &zone->history[zone->next];
+    
+    // Diferenças em 32 bits: corretas mesmo com o contador dando a volta
+    sample->ticks = now->ticks - zone->start.ticks;
+    sample->cache_misses = now->cache_misses - zone->start.cache_misses;
+    sample->instructions = now->instructions - zone->start.instructions;
+    
+    zone->next = (zone->next + 1) % PROFILE_HISTORY;
+    if (zone->count < PROFILE_HISTORY) {
+        zone->count++;
+    }
+    PROFILE_UNLOCK();
+}
+
+void profile_init(void) {
+    for (int c = 0; c < PROFILE_CORES; c++) {
+        for (int i = 0; i < PROFILE_ZONE_COUNT; i++) {
+            cores[c].zones[i].next = 0;
+            cores[c].zones[i].count = 0;
+        }
+        cores[c].frame_marked = false;
+    }
+#if PROFILE_CORES > 1
+    for (int c = 0; c < PROFILE_CORES; c++) {
+        spsc_init(&snapshot_queues[c], snapshot_memory[c], sizeof(ProfileSnapshot), SNAPSHOT_SLOTS);
+        for (int i = 0; i < PROFILE_ZONE_COUNT; i++) {
+            received[c].zones[i].samples = 0;
+        }
+    }
+#endif
+    counters_init();
+}
+
+void profile_init_core(void) {
+    counters_init();
+}
+
+void profile_begin(ProfileZone zone) {
+    read_counters(&cores[PROFILE_CORE()].zones[zone].start);
+}
+
+void profile_end(ProfileZone zone) {
+    ProfileCounters now;
+    read_counters(&now);
+    push_sample(&cores[PROFILE_CORE()].zones[zone], &now);
+}
+
+void profile_frame_mark(void) {
+    CoreProfile *core = &cores[PROFILE_CORE()];
+    ProfileCounters now;
+    read_counters(&now);
+    
+    if (core->frame_marked) {
+        push_sample(&core->zones[PROFILE_FRAME], &now);
+    }
+    core->zones[PROFILE_FRAME].start = now;
+    core->frame_marked = true;
+}
+
+static void zone_stats(const ZoneData *data, ProfileZone zone, ProfileStats *stats) {
+    uint32_t min = UINT32_MAX, max = 0;
+    uint64_t total = 0, misses = 0, instructions = 0;
+    
+    PROFILE_LOCK();
+    uint32_t count = data->count;
+    for (uint32_t i = 0; i < count; i++) {
+        const ProfileCounters *sample = &data->history[i];
+        if (sample->ticks < min) {
+            min = sample->ticks;
+        }
+        if (sample->ticks > max) {
+            max = sample->ticks;
+        }
+        total += sample->ticks;
+        misses += sample->cache_misses;
+        instructions += sample->instructions;
+    }
+    PROFILE_UNLOCK();
+    
+    stats->name = zone_names[zone];
+    stats->samples = count;
+    if (count == 0) {
+        stats->min_us = stats->avg_us = stats->max_us = 0;
+        stats->avg_cache_misses = stats->avg_instructions = 0;
+        return;
+    }
+    
+    // Médias sobre no máximo PROFILE_HISTORY amostras de 32 bits: a soma
+    // dividida pela contagem cabe de volta em 32 bits
+    uint32_t avg = (uint32_t)(total / count);
+    stats->min_us = min / ticks_per_us;
+    stats->avg_us = avg / ticks_per_us;
+    stats->max_us = max / ticks_per_us;
+    stats->avg_cache_misses = (uint32_t)(misses / count);
+    stats->avg_instructions = (uint32_t)(instructions / count);
+}
+
+void profile_publish(void) {
+#if PROFILE_CORES > 1
+    unsigned core = PROFILE_CORE();
+    if (core == 0) {
+        return;
+    }
+    
+    // Fila cheia: o core 0 ainda não leu as anteriores; a próxima vai
+    ProfileSnapshot *snapshot = spsc_reserve(&snapshot_queues[core]);
+    if (!snapshot) {
+        return;
+    }
+    for (int i = 0; i < PROFILE_ZONE_COUNT; i++) {
+        zone_stats(&cores[core].zones[i], (ProfileZone)i, &snapshot->zones[i]);
+    }
+    spsc_publish(&snapshot_queues[core]);
+#endif
+}
+
+#if PROFILE_CORES > 1
+// Core 0: fica com a cópia mais recente publicada por cada core secundário
+static const ProfileStats *received_stats(ProfileZone zone) {
+    for (int c = 1; c < PROFILE_CORES; c++) {
+        const ProfileSnapshot *snapshot;
+        while ((snapshot = spsc_peek(&snapshot_queues[c])) != NULL) {
+            received[c] = *snapshot;
+            spsc_release(&snapshot_queues[c]);
+        }
+        if (received[c].zones[zone].samples) {
+            return &received[c].zones[zone];
+        }
+    }
+    return NULL;
+}
+#endif
+
+void profile_get_stats(ProfileZone zone, ProfileStats *stats) {
+    unsigned core = PROFILE_CORE();
+    
+#if PROFILE_CORES > 1
+    // No core 0, as zonas medidas em outro core (o desenho, com o render no
+    // core 1) vêm das cópias publicadas
+    if (core == 0) {
+        const ProfileStats *remote = received_stats(zone);
+        if (remote) {
+            *stats = *remote;
+            return;
+        }
+    }
+#endif
+    zone_stats(&cores[core].zones[zone], zone, stats);
+}
+
+void profile_report(void) {
+    printf("Perfil (últimas %u amostras por zona, us):\n", PROFILE_HISTORY);
+    printf("  %-8s %8s %8s %8s %10s %12s\n", "zona", "min", "med", "max", "miss L1D", "instr");
+    
+    for (int i = 0; i < PROFILE_ZONE_COUNT; i++) {
+        ProfileStats stats;
+        profile_get_stats((ProfileZone)i, &stats);
+        if (stats.samples == 0) {
+            continue;
+        }
+        printf("  %-8s %8u %8u %8u %10u %12u\n", stats.name, stats.min_us, stats.avg_us,
+               stats.max_us, stats.avg_cache_misses, stats.avg_instructions);
+    }
+}
@@ -0,0 +1,231 @@
+//
+// render.c - Renderização incremental do jogo (dirty rectangles)
+//
+
+#include <stdio.h>
+#include "arena.h"
+#include "game.h"
+#include "graphics.h"
+#include "profile.h"
+#include "render.h"
+
+// Estado dos últimos frames desenhados (renderização incremental)
+static TextCache score_cache;           // Texto de pontuação já desenhado
+static TextCache stats_cache;           // Overlay de FPS já desenhado
+static DirtyCells last_frame_damage;    // Ainda ausente na página de trás
+static int full_redraw_frames = 0;      // Um redesenho completo por página
+
+// Memória de rascunho de um frame, descartada ao fim de draw_game()
+#define FRAME_ARENA_SIZE 1024
+static uint8_t frame_memory[FRAME_ARENA_SIZE];
+static Arena frame_arena;
+
+#define SCORE_TEXT_MAX 32
+
+// Posição do texto de pontuação
+#define SCORE_TEXT_X 10
+#define SCORE_TEXT_Y 10
+
+// Overlay de FPS/tempo de frame (DEBUG_SHOW_FPS), no canto superior
+// direito. Atualizado a cada STATS_REFRESH_FRAMES para continuar legível
+// e não sujar células a todo frame.
+#define STATS_TEXT_MAX 24
+#define STATS_TEXT_X (SCREEN_WIDTH - 10 - (STATS_TEXT_MAX - 1) * 8)
+#define STATS_TEXT_Y 10
+#define STATS_REFRESH_FRAMES 30
+
+static char stats_text[STATS_TEXT_MAX];
+static int stats_len = 0;
+#if DEBUG_SHOW_FPS
+static int stats_age = 0;
+#endif
+
+// Textos sobrepostos de um frame
+typedef struct {
+    const char *score;
+    int score_len;
+    const char *stats;
+    int stats_len;
+} FrameText;
+
+// Verifica se a célula intersecta um retângulo em pixels
+static bool cell_intersects(int grid_x, int grid_y, int x, int y, int width, int height) {
+    int px = grid_x * CELL_SIZE;
+    int py = grid_y * CELL_SIZE;
+    return px < x + width && x < px + CELL_SIZE && py < y + height && y < py + CELL_SIZE;
+}
+
+// Desenhar textos e mensagens de estado (camadas sobre o tabuleiro)
+static void draw_overlay(const Game *game, const FrameText *text) {
+    graphics_draw_string(SCORE_TEXT_X, SCORE_TEXT_Y, text->score, TEXT_COLOR);
+    if (text->stats_len > 0) {
+        graphics_draw_string(STATS_TEXT_X, STATS_TEXT_Y, text->stats, TEXT_COLOR);
+    }
+    
+    if (game->state == GAME_PAUSED) {
+        graphics_draw_rect(SCREEN_WIDTH/2 - 50, SCREEN_HEIGHT/2 - 20,
+                          100, 40, PAUSE_BG_COLOR);
+        graphics_draw_string(SCREEN_WIDTH/2 - 32, SCREEN_HEIGHT/2 - 8,
+                           "PAUSED", TEXT_COLOR);
+    } else if (game->state == GAME_OVER) {
+        graphics_draw_rect(SCREEN_WIDTH/2 - 60, SCREEN_HEIGHT/2 - 30,
+                          120, 60, PAUSE_BG_COLOR);
+        graphics_draw_string(SCREEN_WIDTH/2 - 40, SCREEN_HEIGHT/2 - 16,
+                           "GAME OVER", TEXT_COLOR);
+        graphics_draw_string(SCREEN_WIDTH/2 - 48, SCREEN_HEIGHT/2,
+                           "Press R to restart", TEXT_COLOR);
+    }
+}
+
+// Redesenhar a tela inteira
+static void draw_full(const Game *game, const FrameText *text) {
+    graphics_clear_screen(BACKGROUND_COLOR);
+    
+    // Desenhar cobra
+    for (int i = 0; i < game->snake.length; i++) {
+        uint16_t color = (i == 0) ? SNAKE_HEAD_COLOR : SNAKE_BODY_COLOR;
+        Position segment = snake_segment(&game->snake, i);
+        graphics_draw_game_cell(segment.x, segment.y, color);
+    }
+    
+    // Desenhar comida
+    graphics_draw_game_cell_bordered(game->food.x, game->food.y, FOOD_COLOR, COLOR_WHITE);
+    
+    draw_overlay(game, text);
+}
+
+// Redesenhar uma única célula com todas as camadas que a cobrem,
+// na mesma ordem do redesenho completo (resultado idêntico por pixel)
+static void draw_cell(const Game *game, int grid_x, int grid_y, const FrameText *text) {
+    if (grid_x < 0 || grid_x >= GAME_WIDTH || grid_y < 0 || grid_y >= GAME_HEIGHT) {
+        return;
+    }
+    
+    graphics_set_clip(grid_x * CELL_SIZE, grid_y * CELL_SIZE, CELL_SIZE, CELL_SIZE);
+    graphics_draw_game_cell(grid_x, grid_y, BACKGROUND_COLOR);
+    
+    // Segmentos nunca se sobrepõem: basta o mapa de ocupação e a cabeça
+    Position cell = {grid_x, grid_y};
+    if (snake_occupies(&game->snake, cell)) {
+        Position head = game->snake.body[game->snake.head];
+        bool is_head = head.x == grid_x && head.y == grid_y;
+        graphics_draw_game_cell(grid_x, grid_y, is_head ? SNAKE_HEAD_COLOR : SNAKE_BODY_COLOR);
+    }
+    
+    if (game->food.x == grid_x && game->food.y == grid_y) {
+        graphics_draw_game_cell_bordered(grid_x, grid_y, FOOD_COLOR, COLOR_WHITE);
+    }
+    
+    if (game->state != GAME_RUNNING ||
+        cell_intersects(grid_x, grid_y, SCORE_TEXT_X, SCORE_TEXT_Y, text->score_len * 8, 8) ||
+        cell_intersects(grid_x, grid_y, STATS_TEXT_X, STATS_TEXT_Y, text->stats_len * 8, 8)) {
+        draw_overlay(game, text);
+    }
+    
+    graphics_reset_clip();
+}
+
+// Marcar todas as células cobertas por um retângulo em pixels
+static void mark_rect_dirty(DirtyCells *dirty, int x, int y, int width, int height) {
+    for (int gy = y / CELL_SIZE; gy <= (y + height - 1) / CELL_SIZE; gy++) {
+        for (int gx = x / CELL_SIZE; gx <= (x + width - 1) / CELL_SIZE; gx++) {
+            Position pos = {gx, gy};
+            mark_cell_dirty(dirty, pos);
+        }
+    }
+}
+
+// Texto que mudou: sujar a área do antigo e a do novo
+static void mark_text_dirty(DirtyCells *damage, TextCache *cache, int x, int y,
+                            const char *text, int len) {
+    if (graphics_text_cache_matches(cache, x, y, text, TEXT_COLOR)) {
+        return;
+    }
+    if (cache->valid && cache->width > 0) {
+        mark_rect_dirty(damage, cache->x, cache->y, cache->width, 8);
+    }
+    if (len > 0) {
+        mark_rect_dirty(damage, x, y, len * 8, 8);
+    }
+    graphics_text_cache_store(cache, x, y, text, TEXT_COLOR);
+}
+
+#if DEBUG_SHOW_FPS
+// FPS pela média do intervalo entre frames, mais o custo médio de desenho
+static void update_stats_text(void) {
+    if (stats_age-- > 0) {
+        return;
+    }
+    stats_age = STATS_REFRESH_FRAMES;
+    
+    ProfileStats frame, draw;
+    profile_get_stats(PROFILE_FRAME, &frame);
+    profile_get_stats(PROFILE_DRAW, &draw);
+    if (frame.samples == 0 || frame.avg_us == 0) {
+        return;
+    }
+    
+    stats_len = snprintf(stats_text, sizeof(stats_text), "%u FPS draw %u.%02u ms",
+                         1000000 / frame.avg_us, draw.avg_us / 1000, draw.avg_us % 1000 / 10);
+    if (stats_len >= STATS_TEXT_MAX) {
+        stats_len = STATS_TEXT_MAX - 1;
+    }
+}
+#endif
+
+// Desenhar jogo - apenas as células alteradas desde o último frame
+void draw_game(Game *game) {
+    if (!frame_arena.base) {
+        arena_init(&frame_arena, frame_memory, sizeof(frame_memory));
+    }
+    
+    // Arena esgotada: o texto vai para a pilha, o frame sai igual
+    FrameText text;
+    char score_fallback[SCORE_TEXT_MAX];
+    char *score_text = arena_alloc(&frame_arena, SCORE_TEXT_MAX);
+    if (!score_text) {
+        score_text = score_fallback;
+    }
+    text.score = score_text;
+    text.score_len = snprintf(score_text, SCORE_TEXT_MAX, "Score: %d", game->score);
+#if DEBUG_SHOW_FPS
+    update_stats_text();
+#endif
+    text.stats = stats_text;
+    text.stats_len = stats_len;
+    
+    // Dano deste frame: células do jogo + região dos textos antigos e novos
+    DirtyCells damage = game->dirty;
+    mark_text_dirty(&damage, &score_cache, SCORE_TEXT_X, SCORE_TEXT_Y, text.score, text.score_len);
+    mark_text_dirty(&damage, &stats_cache, STATS_TEXT_X, STATS_TEXT_Y, text.stats, text.stats_len);
+    if (damage.full_redraw) {
+        full_redraw_frames = graphics_page_count();
+    }
+    
+    if (full_redraw_frames > 0) {
+        draw_full(game, &text);
+        full_redraw_frames--;
+    } else {
+        for (int i = 0; i < damage.count; i++) {
+            draw_cell(game, damage.cells[i].x, damage.cells[i].y, &text);
+        }
+        
+        // Com double buffering a página de trás está um frame atrasada
+        if (graphics_page_count() > 1) {
+            for (int i = 0; i < last_frame_damage.count; i++) {
+                draw_cell(game, last_frame_damage.cells[i].x, last_frame_damage.cells[i].y, &text);
+            }
+        }
+    }
+    
+    last_frame_damage = damage;
+    game->dirty.count = 0;
+    game->dirty.full_redraw = false;
+    
+    graphics_swap_buffers();
+    arena_reset(&frame_arena);
+}
+
+void render_get_frame_stats(MemStats *stats) {
+    arena_get_stats(&frame_arena, stats);
+}
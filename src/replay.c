@@ -0,0 +1,152 @@
+//
+// replay.c - Gravação e reprodução determinística de partidas
+//
+
+#include "replay.h"
+#include "game.h"
+
+// Tecla representativa de cada evento na reprodução
+static const unsigned char event_keys[] = {
+    KEY_UP_1, KEY_DOWN_1, KEY_LEFT_1, KEY_RIGHT_1,
+    KEY_PAUSE_1, KEY_RESTART_1, KEY_QUIT_1
+};
+
+static int key_to_event(unsigned char key) {
+    switch (key) {
+        case KEY_UP_1:      case KEY_UP_2:      return REPLAY_UP;
+        case KEY_DOWN_1:    case KEY_DOWN_2:    return REPLAY_DOWN;
+        case KEY_LEFT_1:    case KEY_LEFT_2:    return REPLAY_LEFT;
+        case KEY_RIGHT_1:   case KEY_RIGHT_2:   return REPLAY_RIGHT;
+        case KEY_PAUSE_1:   case KEY_PAUSE_2:   return REPLAY_PAUSE;
+        case KEY_RESTART_1: case KEY_RESTART_2: return REPLAY_RESTART;
+        case KEY_QUIT_1:    case KEY_QUIT_2:    return REPLAY_QUIT;
+        default:                                return -1;
+    }
+}
+
+static void put_byte(ReplayRecorder *rec, uint8_t byte) {
+    if (rec->size >= rec->capacity) {
+        rec->overflow = true;
+        return;
+    }
+    rec->buffer[rec->size++] = byte;
+}
+
+static void put_event(ReplayRecorder *rec, uint32_t tick, int event) {
+    if (rec->overflow) {
+        return;
+    }
+    
+    uint64_t value = ((uint64_t)(tick - rec->last_tick) << 3) | (uint64_t)event;
+    rec->last_tick = tick;
+    
+    // Varint LEB128: 7 bits por byte, bit alto indica continuação
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        put_byte(rec, value ? (byte | 0x80) : byte);
+    } while (value);
+}
+
+void replay_recorder_init(ReplayRecorder *rec, uint8_t *buffer, size_t capacity, uint32_t seed) {
+    rec->buffer = buffer;
+    rec->capacity = capacity;
+    rec->size = 0;
+    rec->last_tick = 0;
+    rec->overflow = false;
+    
+    put_byte(rec, 'S');
+    put_byte(rec, 'N');
+    put_byte(rec, 'K');
+    put_byte(rec, 'R');
+    put_byte(rec, REPLAY_VERSION);
+    for (int i = 0; i < 4; i++) {
+        put_byte(rec, (seed >> (8 * i)) & 0xFF);
+    }
+}
+
+void replay_record_key(ReplayRecorder *rec, uint32_t tick, unsigned char key) {
+    int event = key_to_event(key);
+    if (event >= 0) {
+        put_event(rec, tick, event);
+    }
+}
+
+void replay_record_end(ReplayRecorder *rec, uint32_t tick) {
+    put_event(rec, tick, REPLAY_END);
+}
+
+// Lê o próximo evento; marca o fim do fluxo se os dados acabarem
+static void read_next(ReplayPlayer *player) {
+    uint64_t value = 0;
+    int shift = 0;
+    
+    while (true) {
+        if (player->pos >= player->size || shift > 35) {
+            player->next_event = -1;
+            return;
+        }
+        uint8_t byte = player->data[player->pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        shift += 7;
+        if (!(byte & 0x80)) {
+            break;
+        }
+    }
+    
+    player->next_tick += (uint32_t)(value >> 3);
+    player->next_event = (int)(value & 7);
+}
+
+bool replay_player_init(ReplayPlayer *player, const uint8_t *data, size_t size) {
+    if (size < REPLAY_HEADER_SIZE || data[0] != 'S' || data[1] != 'N' ||
+        data[2] != 'K' || data[3] != 'R' || data[4] != REPLAY_VERSION) {
+        return false;
+    }
+    
+    player->data = data;
+    player->size = size;
+    player->pos = REPLAY_HEADER_SIZE;
+    player->seed = (uint32_t)data[5] | ((uint32_t)data[6] << 8) |
+                   ((uint32_t)data[7] << 16) | ((uint32_t)data[8] << 24);
+    player->next_tick = 0;
+    read_next(player);
+    return true;
+}
+
+bool replay_finished(const ReplayPlayer *player) {
+    return player->next_event < 0 || player->next_event == REPLAY_END;
+}
+
+void replay_apply(ReplayPlayer *player, Game *game) {
+    while (!replay_finished(player) && player->next_tick == game->steps) {
+        handle_input(game, event_keys[player->next_event]);
+        read_next(player);
+    }
+}
+
+uint32_t replay_run(ReplayPlayer *player, Game *game) {
+    game_seed(game, player->seed);
+    init_game(game);
+    
+    while (!replay_finished(player)) {
+        replay_apply(player, game);
+        if (replay_finished(player)) {
+            break;
+        }
+        
+        // Sem evento até o próximo carimbo: avançar direto (pausa não avança passos)
+        if (game->state != GAME_RUNNING && player->next_tick > game->steps) {
+            break;
+        }
+        game_step(game);
+    }
+    
+    // Completar até o passo final gravado
+    if (player->next_event == REPLAY_END) {
+        while (game->steps < player->next_tick && game->state == GAME_RUNNING) {
+            game_step(game);
+        }
+    }
+    return game->steps;
+}
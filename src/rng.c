@@ -0,0 +1,122 @@
+//
+// rng.c - xoshiro128** com faixa de Lemire e semente de hardware
+//
+
+#include "rng.h"
+
+static inline uint32_t rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+// Finalizador do splitmix32: espalha cada bit da entrada por toda a saída
+static uint32_t mix32(uint32_t z) {
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+void rng_seed(Rng *rng, uint32_t seed) {
+    // Sequência de Weyl do splitmix32: as quatro palavras nunca são todas 0
+    for (int i = 0; i < 4; i++) {
+        seed += 0x9E3779B9u;
+        rng->s[i] = mix32(seed);
+    }
+}
+
+uint32_t rng_next(Rng *rng) {
+    uint32_t *s = rng->s;
+    uint32_t result = rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 11);
+    return result;
+}
+
+uint32_t rng_range(Rng *rng, uint32_t bound) {
+    uint64_t m = (uint64_t)rng_next(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    
+    // Só parte baixa menor que bound pode cair na faixa enviesada
+    if (low < bound) {
+        uint32_t threshold = -bound % bound;
+        while (low < threshold) {
+            m = (uint64_t)rng_next(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+#if (defined(__arm__) || defined(__aarch64__)) && !defined(__linux__)
+#include <stdbool.h>
+#include "timer.h"
+
+// RNG de hardware do BCM2835/BCM2837
+#define RNG_BASE            0x3F104000
+#define RNG_CTRL            ((volatile uint32_t*)(RNG_BASE + 0x00))
+#define RNG_STATUS          ((volatile uint32_t*)(RNG_BASE + 0x04))
+#define RNG_DATA            ((volatile uint32_t*)(RNG_BASE + 0x08))
+#define RNG_INT_MASK        ((volatile uint32_t*)(RNG_BASE + 0x10))
+
+#define RNG_CTRL_ENABLE     1
+#define RNG_INT_OFF         1
+#define RNG_WARMUP_COUNT    0x40000     // Números descartados ao ligar
+#define RNG_WORDS(status)   ((status) >> 24)
+
+#define RNG_TIMEOUT_US      20000
+#define JITTER_ROUNDS       64
+
+static bool hardware_seed(uint32_t *seed) {
+    if (!(*RNG_CTRL & RNG_CTRL_ENABLE)) {
+        *RNG_STATUS = RNG_WARMUP_COUNT;
+        *RNG_INT_MASK |= RNG_INT_OFF;
+        *RNG_CTRL |= RNG_CTRL_ENABLE;
+    }
+    
+    uint64_t deadline = get_system_timer() + RNG_TIMEOUT_US;
+    while (RNG_WORDS(*RNG_STATUS) == 0) {
+        if (get_system_timer() > deadline) {
+            return false;
+        }
+    }
+    *seed = *RNG_DATA;
+    return true;
+}
+
+// Sem o RNG: quantas voltas cabem em cada tick de 1 us varia com cache,
+// DMA da USB e IRQs; o instante do boot em que isso roda também varia
+static uint32_t jitter_seed(void) {
+    uint32_t hash = (uint32_t)get_system_timer();
+    
+    for (int i = 0; i < JITTER_ROUNDS; i++) {
+        uint32_t start = (uint32_t)get_system_timer();
+        uint32_t spins = 0;
+        while ((uint32_t)get_system_timer() == start) {
+            spins++;
+        }
+        hash = mix32(rotl(hash, 5) ^ spins);
+    }
+    return hash;
+}
+
+uint32_t rng_entropy_seed(void) {
+    uint32_t seed;
+    if (hardware_seed(&seed)) {
+        return seed;
+    }
+    return jitter_seed();
+}
+#else
+#include <time.h>
+
+uint32_t rng_entropy_seed(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return mix32((uint32_t)ts.tv_sec ^ rotl((uint32_t)ts.tv_nsec, 16));
+}
+#endif
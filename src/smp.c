@@ -0,0 +1,79 @@
+//
+// smp.c - Partida dos cores secundários pelo mailbox 3 do bloco ARM local
+//
+
+#include "smp.h"
+#include "mmu.h"
+#include "timer.h"
+
+#define SMP_START_TIMEOUT_US    100000
+
+// Entrada dos secundários (startup.s/startup64.s): pilha própria, em SVC
+// ou EL1
+extern void secondary_start(void);
+
+#if defined(__aarch64__)
+// Spin table do armstub8: endereço de liberação de 64 bits por core
+#define SPIN_TABLE(core)        ((volatile uint64_t*)(uintptr_t)(0xD8 + 8 * (core)))
+
+static void release_core(unsigned core) {
+    *SPIN_TABLE(core) = (uintptr_t)secondary_start;
+    
+    // O core parado lê a tabela com a MMU desligada: direto da memória
+    dcache_clean_range(SPIN_TABLE(core), sizeof(uint64_t));
+}
+#else
+// Mailbox 3 de cada core: escrita em SET, leitura/limpeza em CLR
+#define LOCAL_BASE              0x40000000
+#define CORE_MAILBOX3_SET(core) ((volatile uint32_t*)(LOCAL_BASE + 0x8C + 0x10 * (core)))
+
+static void release_core(unsigned core) {
+    *CORE_MAILBOX3_SET(core) = (uint32_t)(uintptr_t)secondary_start;
+}
+#endif
+
+static SmpEntry *volatile core_entry[SMP_CORES];
+static void *volatile core_param[SMP_CORES];
+static volatile bool core_running[SMP_CORES];
+
+void secondary_main(unsigned core);
+
+bool smp_start_core(unsigned core, SmpEntry *entry, void *param) {
+    if (core == 0 || core >= SMP_CORES || core_running[core] || !entry) {
+        return false;
+    }
+    
+    core_entry[core] = entry;
+    core_param[core] = param;
+    
+    // Entrada e parâmetro visíveis antes do endereço de partida
+    __asm__ volatile("dsb sy" ::: "memory");
+    release_core(core);
+    smp_signal_event();
+    
+    uint64_t deadline = get_system_timer() + SMP_START_TIMEOUT_US;
+    while (!core_running[core]) {
+        if (get_system_timer() > deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool smp_core_running(unsigned core) {
+    return core < SMP_CORES && core_running[core];
+}
+
+// Chamado pelo startup.s em cada core liberado
+void secondary_main(unsigned core) {
+    core_running[core] = true;
+    __asm__ volatile("dmb sy" ::: "memory");
+    
+    core_entry[core](core, core_param[core]);
+    
+    // A entrada retornou: o core volta a dormir
+    core_running[core] = false;
+    while (true) {
+        smp_wait_event();
+    }
+}
@@ -0,0 +1,65 @@
+//
+// spsc.c - Fila SPSC de slots fixos para troca de dados entre cores
+//
+
+#include "spsc.h"
+
+#if (defined(__arm__) || defined(__aarch64__)) && !defined(__linux__)
+// Entre cores do mesmo cluster: ordena os dados do slot contra os índices
+#define spsc_barrier()  __asm__ volatile("dmb sy" ::: "memory")
+#else
+#define spsc_barrier()  __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+bool spsc_init(SpscQueue *queue, void *memory, size_t slot_size, uint32_t capacity) {
+    if (!memory || slot_size == 0 || capacity == 0 || (capacity & (capacity - 1))) {
+        return false;
+    }
+    
+    queue->slots = memory;
+    queue->slot_size = (uint32_t)SPSC_SLOT_SIZE(slot_size);
+    queue->capacity = capacity;
+    queue->head = 0;
+    queue->tail = 0;
+    return true;
+}
+
+static inline void *slot_at(SpscQueue *queue, uint32_t index) {
+    return queue->slots + (size_t)(index & (queue->capacity - 1)) * queue->slot_size;
+}
+
+void *spsc_reserve(SpscQueue *queue) {
+    uint32_t head = queue->head;
+    
+    if (head - queue->tail >= queue->capacity) {
+        return NULL;
+    }
+    
+    // O consumidor terminou de ler o slot antes de publicar o tail
+    spsc_barrier();
+    return slot_at(queue, head);
+}
+
+void spsc_publish(SpscQueue *queue) {
+    // Conteúdo do slot visível antes do novo head
+    spsc_barrier();
+    queue->head = queue->head + 1;
+}
+
+const void *spsc_peek(SpscQueue *queue) {
+    uint32_t tail = queue->tail;
+    
+    if (queue->head == tail) {
+        return NULL;
+    }
+    
+    // Leitura do slot só depois de ver o head que o publicou
+    spsc_barrier();
+    return slot_at(queue, tail);
+}
+
+void spsc_release(SpscQueue *queue) {
+    // Leituras do slot concluídas antes de devolvê-lo ao produtor
+    spsc_barrier();
+    queue->tail = queue->tail + 1;
+}
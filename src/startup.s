@@ -3,6 +3,23 @@
  * Configuração inicial do sistema antes de chamar main()
  */
 
+.arch_extension virt
+
+/* Modos do processador (CPSR[4:0]) */
+.equ MODE_IRQ,  0x12
+.equ MODE_SVC,  0x13
+.equ MODE_HYP,  0x1A
+.equ MODE_MASK, 0x1F
+.equ PSR_I,     0x80
+.equ PSR_F,     0x40
+
+.equ IRQ_STACK_SIZE, 0x1000
+
+/* Cores secundários (smp.h): pilha SVC de cada um e mailbox 3 local */
+.equ CORE_STACK_SIZE, 0x4000
+.equ SECONDARY_CORES, 3
+.equ CORE_MAILBOX3_CLR, 0x400000CC
+
 .section .text.boot
 
 .global _start
@@ -11,11 +28,22 @@ _start:
     /* Desabilitar IRQ e FIQ */
     cpsid if
     
-    /* Verificar se somos o core 0 */
+    /* Verificar se somos o core 0; os outros esperam ser liberados */
     mrc p15, 0, r0, c0, c0, 5
     and r0, r0, #3
     cmp r0, #0
-    bne halt
+    bne secondary_park
+    
+    /* O firmware do Pi 3 entrega o core em HYP: descer para SVC, onde o
+       VBAR e os modos de exceção usuais valem */
+    ldr r2, =in_svc
+    bl leave_hyp
+    
+in_svc:
+    /* Stack do modo IRQ */
+    cps #MODE_IRQ
+    ldr sp, =irq_stack_top
+    cps #MODE_SVC
     
     /* Configurar stack pointer */
     ldr r0, =_start
@@ -33,21 +61,86 @@ clear_bss:
     b clear_bss
     
 bss_cleared:
-    /* Habilitar cache L1 */
+    bl core_setup
+    
+    /* Chamar main() */
+    bl main
+    
+halt:
+    wfi
+    b halt
+
+/* Se estiver em HYP, desce para SVC (IRQ/FIQ mascaradas) e continua em r2;
+   senão retorna normalmente */
+leave_hyp:
+    mrs r0, cpsr
+    and r1, r0, #MODE_MASK
+    cmp r1, #MODE_HYP
+    bxne lr
+    bic r0, r0, #MODE_MASK
+    orr r0, r0, #(MODE_SVC | PSR_I | PSR_F)
+    msr spsr_hyp, r0
+    msr elr_hyp, r2
+    eret
+
+/* Configuração por core: caches L1, VFP/NEON e vector table */
+core_setup:
+    /* Habilitar cache L1 (a de dados só vale com a MMU ligada: mmu.c) */
     mrc p15, 0, r0, c1, c0, 0
     orr r0, r0, #(1 << 2)  /* Data cache */
     orr r0, r0, #(1 << 12) /* Instruction cache */
     mcr p15, 0, r0, c1, c0, 0
     
+    /* Habilitar VFP/NEON (acesso total a cp10 e cp11) */
+    mrc p15, 0, r0, c1, c0, 2
+    orr r0, r0, #(0xF << 20)
+    mcr p15, 0, r0, c1, c0, 2
+    isb
+    mov r0, #(1 << 30)     /* FPEXC.EN */
+    vmsr fpexc, r0
+    
     /* Configurar vector table */
     ldr r0, =vector_table
     mcr p15, 0, r0, c12, c0, 0
+    bx lr
+
+/* Secundários que entraram pelo _start (kernel_old ou QEMU) fazem o mesmo
+   que o armstub do firmware: esperam um endereço no mailbox 3 */
+secondary_park:
+    ldr r1, =CORE_MAILBOX3_CLR
+    add r1, r1, r0, lsl #4
+1:
+    wfe
+    ldr r2, [r1]
+    cmp r2, #0
+    beq 1b
+    str r2, [r1]           /* Escrever 1 limpa os bits */
+    bx r2
+
+/* Entrada dos cores liberados por smp_start_core() */
+.global secondary_start
+secondary_start:
+    cpsid if
+    ldr r2, =secondary_svc
+    bl leave_hyp
     
-    /* Chamar main() */
-    bl main
+secondary_svc:
+    /* Pilha do core n: topo do slot n-1 */
+    mrc p15, 0, r4, c0, c0, 5
+    and r4, r4, #3
+    ldr r1, =core_stacks
+    mov r2, #CORE_STACK_SIZE
+    mla sp, r4, r2, r1
     
-halt:
-    wfi
+    bl core_setup
+    
+    /* Mesma tabela do core 0 (mmu.c): sem ela as escritas do core 0 que
+       ainda estão na cache dele seriam invisíveis aqui */
+    bl mmu_enable
+    
+    /* secondary_main(core) em smp.c; IRQs ficam com o core 0 */
+    mov r0, r4
+    bl secondary_main
     b halt
 
 /* Vector table básica */
@@ -88,15 +181,36 @@ unused_handler:
     b unused_handler
 
 irq_handler:
-    /* Salvar contexto */
-    push {r0-r12, lr}
+    /* Salvar contexto (registradores caller-saved, inclusive VFP/NEON:
+       o código C pode usar d0-d7 e d16-d31) */
+    sub lr, lr, #4
+    push {r0-r3, r12, lr}
+    vmrs r0, fpscr
+    push {r0, r1}
+    vpush {d0-d7}
+    vpush {d16-d31}
     
-    /* Chamar handler C se necessário */
-    bl timer_handler
+    /* Despachar as linhas pendentes (interrupts.c) */
+    bl irq_dispatch
     
-    /* Restaurar contexto */
-    pop {r0-r12, lr}
-    subs pc, lr, #4
+    /* Restaurar contexto e voltar (CPSR <- SPSR_irq) */
+    vpop {d16-d31}
+    vpop {d0-d7}
+    pop {r0, r1}
+    vmsr fpscr, r0
+    ldm sp!, {r0-r3, r12, pc}^
 
 fiq_handler:
-    b fiq_handler
\ No newline at end of file
+    b fiq_handler
+
+/* Stack do modo IRQ */
+.section .bss
+.align 4
+irq_stack:
+    .space IRQ_STACK_SIZE
+irq_stack_top:
+
+/* Pilhas SVC dos cores 1-3 */
+.align 4
+core_stacks:
+    .space CORE_STACK_SIZE * SECONDARY_CORES
@@ -0,0 +1,275 @@
+/*
+ * startup64.s - Boot code AArch64 para Raspberry Pi 3 (kernel8.img)
+ * O firmware (armstub8) entrega os cores em EL2; o jogo roda em EL1
+ */
+
+/* SCR_EL3: NS, RES1, SMD, HCE e EL2 em AArch64 (só se entrarmos em EL3) */
+.equ SCR_EL3_VALUE,  0x5B1
+/* SPSR para o eret: EL2h/EL1h (pilha do próprio nível) com DAIF mascarado */
+.equ SPSR_EL2H,      0x3C9
+.equ SPSR_EL1H,      0x3C5
+/* HCR_EL2.RW: EL1 em AArch64 */
+.equ HCR_RW,         (1 << 31)
+/* CPTR_EL2 sem traps de FP/NEON (bits RES1 ligados) */
+.equ CPTR_EL2_VALUE, 0x33FF
+/* SCTLR_EL1 com os bits RES1, MMU e caches desligadas (mmu.c liga) */
+.equ SCTLR_EL1_VALUE, 0x30D00800
+/* CPACR_EL1.FPEN: FP/NEON sem trap em EL1 */
+.equ CPACR_FPEN,     (3 << 20)
+
+/* Quadro salvo pelo vetor de IRQ: x0-x18, x29, x30 (+ alinhamento),
+   v0-v7, v16-v31, FPCR e FPSR */
+.equ IRQ_GPR_SIZE,   (22 * 8)
+.equ IRQ_FRAME_SIZE, (IRQ_GPR_SIZE + 24 * 16 + 16)
+
+/* Cores secundários (smp.h): pilha de EL1 de cada um e spin table */
+.equ CORE_STACK_SIZE, 0x4000
+.equ SECONDARY_CORES, 3
+.equ SPIN_TABLE_BASE, 0xD8
+
+.section .text.boot
+
+.global _start
+
+_start:
+    /* Verificar se somos o core 0; os outros esperam ser liberados */
+    mrs x0, mpidr_el1
+    and x0, x0, #3
+    cbnz x0, secondary_park
+    
+    ldr x2, =in_el1
+    bl drop_to_el1
+    
+in_el1:
+    /* Pilha abaixo do kernel (cresce para baixo a partir de 0x80000) */
+    ldr x0, =_start
+    mov sp, x0
+    
+    /* Limpar BSS section (limites alinhados em 16 no kernel8.ld) */
+    ldr x0, =__bss_start
+    ldr x1, =__bss_end
+    
+clear_bss:
+    cmp x0, x1
+    b.hs bss_cleared
+    stp xzr, xzr, [x0], #16
+    b clear_bss
+    
+bss_cleared:
+    bl core_setup
+    
+    /* Chamar main() */
+    bl main
+    
+halt:
+    wfi
+    b halt
+
+/* Desce de EL3/EL2 para EL1h (DAIF mascarado) e continua em x2; em EL1,
+   só salta para x2 */
+drop_to_el1:
+    mrs x0, CurrentEL
+    lsr x0, x0, #2
+    cmp x0, #3
+    b.ne 1f
+    ldr x0, =SCR_EL3_VALUE
+    msr scr_el3, x0
+    mov x0, #SPSR_EL2H
+    msr spsr_el3, x0
+    adr x0, 1f
+    msr elr_el3, x0
+    eret
+    
+1:
+    mrs x0, CurrentEL
+    lsr x0, x0, #2
+    cmp x0, #2
+    b.ne 2f
+    
+    /* Contador e timer físicos acessíveis em EL1, sem deslocamento */
+    mrs x0, cnthctl_el2
+    orr x0, x0, #3
+    msr cnthctl_el2, x0
+    msr cntvoff_el2, xzr
+    
+    /* FP/NEON, registradores de sistema e a PMU inteira livres para EL1 */
+    ldr x0, =CPTR_EL2_VALUE
+    msr cptr_el2, x0
+    msr hstr_el2, xzr
+    mrs x0, pmcr_el0
+    ubfx x0, x0, #11, #5    /* MDCR_EL2.HPMN = PMCR.N */
+    msr mdcr_el2, x0
+    
+    ldr x0, =HCR_RW
+    msr hcr_el2, x0
+    ldr x0, =SCTLR_EL1_VALUE
+    msr sctlr_el1, x0
+    
+    mov x0, #SPSR_EL1H
+    msr spsr_el2, x0
+    msr elr_el2, x2
+    eret
+    
+2:
+    br x2
+
+/* Configuração por core em EL1: FP/NEON e vector table */
+core_setup:
+    mov x0, #CPACR_FPEN
+    msr cpacr_el1, x0
+    ldr x0, =vector_table
+    msr vbar_el1, x0
+    isb
+    ret
+
+/* Secundários que entraram pelo _start (QEMU ou sem armstub) fazem o mesmo
+   que o armstub8: esperam um endereço na spin table */
+secondary_park:
+    ldr x1, =SPIN_TABLE_BASE
+    add x1, x1, x0, lsl #3
+1:
+    wfe
+    ldr x2, [x1]
+    cbz x2, 1b
+    br x2
+
+/* Entrada dos cores liberados por smp_start_core() */
+.global secondary_start
+secondary_start:
+    ldr x2, =secondary_el1
+    bl drop_to_el1
+    
+secondary_el1:
+    /* Pilha do core n: topo do slot n-1 */
+    mrs x19, mpidr_el1
+    and x19, x19, #3
+    ldr x1, =core_stacks
+    mov x2, #CORE_STACK_SIZE
+    madd x1, x19, x2, x1
+    mov sp, x1
+    
+    bl core_setup
+    
+    /* Mesma tabela do core 0 (mmu.c) */
+    bl mmu_enable
+    
+    /* secondary_main(core) em smp.c; IRQs ficam com o core 0 */
+    mov x0, x19
+    bl secondary_main
+    b halt
+
+/* Vector table AArch64: 4 grupos (EL atual com SP_EL0, EL atual com SP_ELx,
+   EL inferior em AArch64, EL inferior em AArch32) de 4 entradas de 0x80
+   bytes (síncrona, IRQ, FIQ, SError). Só a IRQ em EL1h é tratada. */
+.macro vector_entry target
+    .balign 0x80
+    b \target
+.endm
+
+.balign 0x800
+vector_table:
+    vector_entry sync_handler
+    vector_entry irq_handler
+    vector_entry fiq_handler
+    vector_entry serror_handler
+    
+    vector_entry sync_handler
+    vector_entry irq_handler
+    vector_entry fiq_handler
+    vector_entry serror_handler
+    
+    vector_entry sync_handler
+    vector_entry unused_handler
+    vector_entry unused_handler
+    vector_entry unused_handler
+    
+    vector_entry sync_handler
+    vector_entry unused_handler
+    vector_entry unused_handler
+    vector_entry unused_handler
+
+/* Exception handlers básicos */
+sync_handler:
+    b sync_handler
+    
+fiq_handler:
+    b fiq_handler
+    
+serror_handler:
+    b serror_handler
+    
+unused_handler:
+    b unused_handler
+    
+irq_handler:
+    /* Salvar contexto (registradores caller-saved, inclusive FP/NEON: o
+       código C pode usar v0-v7 e v16-v31). Em EL1h a IRQ usa a pilha do
+       código interrompido; o AArch64 não tem red zone. */
+    sub sp, sp, #IRQ_FRAME_SIZE
+    stp x0, x1, [sp, #0]
+    stp x2, x3, [sp, #16]
+    stp x4, x5, [sp, #32]
+    stp x6, x7, [sp, #48]
+    stp x8, x9, [sp, #64]
+    stp x10, x11, [sp, #80]
+    stp x12, x13, [sp, #96]
+    stp x14, x15, [sp, #112]
+    stp x16, x17, [sp, #128]
+    stp x18, x29, [sp, #144]
+    str x30, [sp, #160]
+    add x0, sp, #IRQ_GPR_SIZE
+    stp q0, q1, [x0, #0]
+    stp q2, q3, [x0, #32]
+    stp q4, q5, [x0, #64]
+    stp q6, q7, [x0, #96]
+    stp q16, q17, [x0, #128]
+    stp q18, q19, [x0, #160]
+    stp q20, q21, [x0, #192]
+    stp q22, q23, [x0, #224]
+    stp q24, q25, [x0, #256]
+    stp q26, q27, [x0, #288]
+    stp q28, q29, [x0, #320]
+    stp q30, q31, [x0, #352]
+    mrs x1, fpcr
+    mrs x2, fpsr
+    stp x1, x2, [x0, #384]
+    
+    /* Despachar as linhas pendentes (interrupts.c) */
+    bl irq_dispatch
+    
+    /* Restaurar contexto e voltar (PC <- ELR_EL1, PSTATE <- SPSR_EL1) */
+    add x0, sp, #IRQ_GPR_SIZE
+    ldp x1, x2, [x0, #384]
+    msr fpcr, x1
+    msr fpsr, x2
+    ldp q0, q1, [x0, #0]
+    ldp q2, q3, [x0, #32]
+    ldp q4, q5, [x0, #64]
+    ldp q6, q7, [x0, #96]
+    ldp q16, q17, [x0, #128]
+    ldp q18, q19, [x0, #160]
+    ldp q20, q21, [x0, #192]
+    ldp q22, q23, [x0, #224]
+    ldp q24, q25, [x0, #256]
+    ldp q26, q27, [x0, #288]
+    ldp q28, q29, [x0, #320]
+    ldp q30, q31, [x0, #352]
+    ldp x0, x1, [sp, #0]
+    ldp x2, x3, [sp, #16]
+    ldp x4, x5, [sp, #32]
+    ldp x6, x7, [sp, #48]
+    ldp x8, x9, [sp, #64]
+    ldp x10, x11, [sp, #80]
+    ldp x12, x13, [sp, #96]
+    ldp x14, x15, [sp, #112]
+    ldp x16, x17, [sp, #128]
+    ldp x18, x29, [sp, #144]
+    ldr x30, [sp, #160]
+    add sp, sp, #IRQ_FRAME_SIZE
+    eret
+
+/* Pilhas de EL1 dos cores 1-3 */
+.section .bss
+.balign 16
+core_stacks:
+    .space CORE_STACK_SIZE * SECONDARY_CORES
@@ -6,96 +6,195 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
+#include "format.h"
+#include "heap.h"
+#include "pool.h"
+#include "rng.h"
+#include "interrupts.h"
+#include "mmu.h"
+#include "timer.h"
+#include "timer_wheel.h"
+#include "uart.h"
 
 // ================================
 // MEMORY MANAGEMENT
 // ================================
 
-// Heap simples para malloc/free
+// Região do heap; o alocador está em heap.c. O heap também é usado em
+// contexto de IRQ (USPi, timers do kernel), então o acesso mascara IRQ.
 #define HEAP_SIZE (1024 * 1024)  // 1MB de heap
-static uint8_t heap[HEAP_SIZE];
-static uint32_t heap_ptr = 0;
+static uint8_t heap[HEAP_SIZE] __attribute__((aligned(HEAP_ALIGN)));
+
+// Pools na frente do heap para os pedidos pequenos mais frequentes
+// (requisições USB e buffers curtos de transferência da USPi). Sem trava:
+// não precisam mascarar IRQ. Esgotado o pool, o pedido vai para o heap.
+// Regiões alinhadas à linha de cache: com blocos de 64 e 256 bytes, cada
+// buffer de DMA da USPi ocupa linhas inteiras e a manutenção de cache de
+// uma transferência não atinge o bloco vizinho.
+#define SMALL_POOLS 2
+static const struct {
+    uint32_t block_size;
+    uint32_t count;
+} small_pool_config[SMALL_POOLS] = {
+    { 64, 256 },
+    { 256, 64 },
+};
+static uint8_t small_pool_memory_0[POOL_REGION_SIZE(64, 256)] __attribute__((aligned(CACHE_LINE_SIZE)));
+static uint8_t small_pool_memory_1[POOL_REGION_SIZE(256, 64)] __attribute__((aligned(CACHE_LINE_SIZE)));
+static uint8_t *const small_pool_memory[SMALL_POOLS] = { small_pool_memory_0, small_pool_memory_1 };
+static Pool small_pools[SMALL_POOLS];
+
+void* memset(void* s, int c, size_t n);
+void* memcpy(void* dest, const void* src, size_t n);
+
+static Pool *small_pool_for_size(size_t size) {
+    for (int i = 0; i < SMALL_POOLS; i++) {
+        if (size <= small_pool_config[i].block_size) {
+            return &small_pools[i];
+        }
+    }
+    return NULL;
+}
+
+static Pool *small_pool_owner(const void *ptr) {
+    for (int i = 0; i < SMALL_POOLS; i++) {
+        if (pool_owns(&small_pools[i], ptr)) {
+            return &small_pools[i];
+        }
+    }
+    return NULL;
+}
+
+// Estatísticas dos pools do malloc (false além do último)
+bool malloc_get_pool_stats(unsigned index, MemStats *stats) {
+    if (index >= SMALL_POOLS) {
+        return false;
+    }
+    pool_get_stats(&small_pools[index], stats);
+    return true;
+}
 
 void* malloc(size_t size) {
-    // Alinha o tamanho para 8 bytes
-    size = (size + 7) & ~7;
-    
-    if (heap_ptr + size > HEAP_SIZE) {
-        return NULL;  // Sem memória suficiente
+    Pool *pool = small_pool_for_size(size);
+    if (pool) {
+        void* ptr = pool_alloc(pool);
+        if (ptr) {
+            return ptr;
+        }
     }
     
-    void* ptr = &heap[heap_ptr];
-    heap_ptr += size;
+    uint32_t flags = irq_save();
+    void* ptr = heap_alloc(size);
+    irq_restore(flags);
     return ptr;
 }
 
 void free(void* ptr) {
-    // Implementação simples - não libera realmente a memória
-    // Para um sistema mais complexo, você implementaria um gerenciador real
-    (void)ptr;  // Evita warning de parâmetro não usado
+    if (!ptr) {
+        return;
+    }
+    
+    Pool *pool = small_pool_owner(ptr);
+    if (pool) {
+        pool_free(pool, ptr);
+        return;
+    }
+    
+    uint32_t flags = irq_save();
+    heap_free(ptr);
+    irq_restore(flags);
 }
 
 void* calloc(size_t nmemb, size_t size) {
-    size_t total_size = nmemb * size;
-    void* ptr = malloc(total_size);
+    if (size && nmemb > (size_t)-1 / size) {
+        return NULL;
+    }
+    
+    void* ptr = malloc(nmemb * size);
     if (ptr) {
-        // Zera a memória alocada
-        uint8_t* byte_ptr = (uint8_t*)ptr;
-        for (size_t i = 0; i < total_size; i++) {
-            byte_ptr[i] = 0;
-        }
+        memset(ptr, 0, nmemb * size);
     }
     return ptr;
 }
 
 void* realloc(void* ptr, size_t size) {
-    // Implementação simples - aloca novo bloco e copia
-    if (!ptr) {
-        return malloc(size);
-    }
+    Pool *pool = ptr ? small_pool_owner(ptr) : NULL;
     
-    void* new_ptr = malloc(size);
-    if (new_ptr && ptr) {
-        // Copia os dados (assumindo que o tamanho antigo era menor)
-        uint8_t* src = (uint8_t*)ptr;
-        uint8_t* dst = (uint8_t*)new_ptr;
-        for (size_t i = 0; i < size; i++) {
-            dst[i] = src[i];
+    if (pool) {
+        // Ainda cabe no bloco do pool
+        if (size && size <= pool->block_size) {
+            return ptr;
+        }
+        void* new_ptr = size ? malloc(size) : NULL;
+        if (new_ptr) {
+            memcpy(new_ptr, ptr, pool->block_size < size ? pool->block_size : size);
+        }
+        if (new_ptr || !size) {
+            pool_free(pool, ptr);
         }
+        return new_ptr;
     }
+    
+    uint32_t flags = irq_save();
+    void* new_ptr = heap_realloc(ptr, size);
+    irq_restore(flags);
     return new_ptr;
 }
 
-// ================================
-// TIMER FUNCTIONS
-// ================================
+// Buffers de DMA/VideoCore: direto no heap, alinhados e completados até a
+// linha de cache, como os blocos dos pools. Nunca dividem linha com outro
+// bloco nem com um cabeçalho do heap, então invalidá-los não descarta
+// dados vizinhos.
+static size_t dma_padded_size(size_t size) {
+    size_t padded = (size + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+    return padded < size ? 0 : padded;
+}
 
-// Função para acessar o timer do sistema
-static uint64_t get_system_timer(void) {
-    volatile uint32_t* timer_clo = (uint32_t*)0x3F003004;
-    volatile uint32_t* timer_chi = (uint32_t*)0x3F003008;
-    
-    uint32_t hi1 = *timer_chi;
-    uint32_t lo = *timer_clo;
-    uint32_t hi2 = *timer_chi;
+void* dma_alloc(size_t size) {
+    size_t padded = dma_padded_size(size);
+    if (size && !padded) {
+        return NULL;
+    }
     
-    if (hi1 != hi2) {
-        lo = *timer_clo;
+    uint32_t flags = irq_save();
+    void* ptr = heap_alloc_aligned(padded, CACHE_LINE_SIZE);
+    irq_restore(flags);
+    return ptr;
+}
+
+// Cresce ou encolhe no lugar quando dá (o início, e com ele o alinhamento,
+// não muda); só move quando precisa, para outro bloco alinhado
+void* dma_realloc(void* ptr, size_t size) {
+    size_t padded = dma_padded_size(size);
+    if (size && !padded) {
+        return NULL;
     }
     
-    return ((uint64_t)hi2 << 32) | lo;
+    uint32_t flags = irq_save();
+    void* new_ptr = heap_realloc_aligned(ptr, padded, CACHE_LINE_SIZE);
+    irq_restore(flags);
+    return new_ptr;
+}
+
+void dma_free(void* ptr) {
+    uint32_t flags = irq_save();
+    heap_free(ptr);
+    irq_restore(flags);
 }
 
+// ================================
+// TIMER FUNCTIONS
+// ================================
+
+// get_system_timer() está em timer.c
+
+// Esperas em milissegundos dormem em WFI até o prazo
 void MsDelay(unsigned nMilliSeconds) {
-    uint64_t start = get_system_timer();
-    uint64_t delay_us = (uint64_t)nMilliSeconds * 1000;
-    
-    while ((get_system_timer() - start) < delay_us) {
-        // Busy wait
-        __asm__ volatile("nop");
-    }
+    timer_sleep_until(get_system_timer() + (uint64_t)nMilliSeconds * 1000);
 }
 
+// Esperas em microssegundos são curtas demais para valer o comparador
 void usDelay(unsigned nMicroSeconds) {
     uint64_t start = get_system_timer();
     
@@ -108,115 +207,109 @@ void usDelay(unsigned nMicroSeconds) {
 // RANDOM NUMBER GENERATION
 // ================================
 
-static unsigned int seed = 1;
+// Mesmo gerador dos jogos (rng.c); sem srand() vale a semente 1
+static Rng rand_rng;
+static bool rand_seeded = false;
 
 void srand(unsigned int s) {
-    seed = s;
+    rng_seed(&rand_rng, s);
+    rand_seeded = true;
 }
 
+// 0..RAND_MAX (2^31 - 1)
 int rand(void) {
-    seed = seed * 1103515245 + 12345;
-    return (seed / 65536) % 32768;
+    if (!rand_seeded) {
+        srand(1);
+    }
+    return (int)(rng_next(&rand_rng) >> 1);
 }
 
 // ================================
 // STRING AND I/O FUNCTIONS
 // ================================
 
-// Função básica para escrever caractere (você pode implementar via UART/GPU)
-static void putchar_basic(char c) {
-    // Para Raspberry Pi 3, UART está em 0x3F201000
-    volatile uint32_t* uart_dr = (uint32_t*)0x3F201000;
-    volatile uint32_t* uart_fr = (uint32_t*)0x3F201018;
+// Sink da UART: acumula na pilha e entrega ao anel de TX em blocos
+#define UART_SINK_BUFFER 64
+
+typedef struct {
+    char data[UART_SINK_BUFFER];
+    size_t len;
+} UartSinkBuffer;
+
+static void uart_sink_flush(UartSinkBuffer *buf) {
+    uart_write(buf->data, buf->len);
+    buf->len = 0;
+}
+
+static void uart_sink(void *context, const char *data, size_t len) {
+    UartSinkBuffer *buf = (UartSinkBuffer *)context;
     
-    // Espera até que o transmissor esteja livre
-    while (*uart_fr & (1 << 5)) {
-        __asm__ volatile("nop");
+    if (buf->len + len > sizeof(buf->data)) {
+        uart_sink_flush(buf);
+        if (len > sizeof(buf->data)) {
+            uart_write(data, len);
+            return;
+        }
+    }
+    memcpy(buf->data + buf->len, data, len);
+    buf->len += len;
+}
+
+static void uart_sink_printf(UartSinkBuffer *buf, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vformat(uart_sink, buf, format, args);
+    va_end(args);
+}
+
+// Sink de string limitado: guarda até size-1 caracteres e segue contando
+typedef struct {
+    char *out;
+    size_t size;
+    size_t pos;
+} StringSink;
+
+static void string_sink(void *context, const char *data, size_t len) {
+    StringSink *sink = (StringSink *)context;
+    
+    if (sink->pos + 1 < sink->size) {
+        size_t room = sink->size - 1 - sink->pos;
+        memcpy(sink->out + sink->pos, data, len < room ? len : room);
     }
+    sink->pos += len;
+}
+
+int vprintf(const char* format, va_list args) {
+    UartSinkBuffer buf;
+    buf.len = 0;
     
-    *uart_dr = c;
+    int count = vformat(uart_sink, &buf, format, args);
+    uart_sink_flush(&buf);
+    return count;
 }
 
 int printf(const char* format, ...) {
     va_list args;
     va_start(args, format);
+    int count = vprintf(format, args);
+    va_end(args);
+    return count;
+}
+
+int vsnprintf(char* str, size_t size, const char* format, va_list args) {
+    StringSink sink = { str, size, 0 };
     
-    int count = 0;
-    const char* p = format;
-    
-    while (*p) {
-        if (*p == '%' && *(p + 1)) {
-            p++;
-            switch (*p) {
-                case 'd': {
-                    int val = va_arg(args, int);
-                    if (val < 0) {
-                        putchar_basic('-');
-                        val = -val;
-                        count++;
-                    }
-                    
-                    char buffer[12];
-                    int i = 0;
-                    do {
-                        buffer[i++] = '0' + (val % 10);
-                        val /= 10;
-                    } while (val);
-                    
-                    for (int j = i - 1; j >= 0; j--) {
-                        putchar_basic(buffer[j]);
-                        count++;
-                    }
-                    break;
-                }
-                case 'x': {
-                    unsigned int val = va_arg(args, unsigned int);
-                    char hex[] = "0123456789abcdef";
-                    char buffer[9];
-                    int i = 0;
-                    
-                    do {
-                        buffer[i++] = hex[val % 16];
-                        val /= 16;
-                    } while (val);
-                    
-                    for (int j = i - 1; j >= 0; j--) {
-                        putchar_basic(buffer[j]);
-                        count++;
-                    }
-                    break;
-                }
-                case 's': {
-                    char* str = va_arg(args, char*);
-                    while (*str) {
-                        putchar_basic(*str++);
-                        count++;
-                    }
-                    break;
-                }
-                case 'c': {
-                    char c = (char)va_arg(args, int);
-                    putchar_basic(c);
-                    count++;
-                    break;
-                }
-                case '%':
-                    putchar_basic('%');
-                    count++;
-                    break;
-                default:
-                    putchar_basic('%');
-                    putchar_basic(*p);
-                    count += 2;
-                    break;
-            }
-        } else {
-            putchar_basic(*p);
-            count++;
-        }
-        p++;
+    int count = vformat(string_sink, &sink, format, args);
+    if (size) {
+        str[sink.pos < size ? sink.pos : size - 1] = '\0';
     }
-    
+    return count;
+}
+
+int snprintf(char* str, size_t size, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(str, size, format, args);
     va_end(args);
     return count;
 }
@@ -224,64 +317,7 @@ int printf(const char* format, ...) {
 int sprintf(char* str, const char* format, ...) {
     va_list args;
     va_start(args, format);
-    
-    int count = 0;
-    const char* p = format;
-    char* out = str;
-    
-    while (*p) {
-        if (*p == '%' && *(p + 1)) {
-            p++;
-            switch (*p) {
-                case 'd': {
-                    int val = va_arg(args, int);
-                    if (val < 0) {
-                        *out++ = '-';
-                        val = -val;
-                        count++;
-                    }
-                    
-                    char buffer[12];
-                    int i = 0;
-                    do {
-                        buffer[i++] = '0' + (val % 10);
-                        val /= 10;
-                    } while (val);
-                    
-                    for (int j = i - 1; j >= 0; j--) {
-                        *out++ = buffer[j];
-                        count++;
-                    }
-                    break;
-                }
-                case 's': {
-                    char* s = va_arg(args, char*);
-                    while (*s) {
-                        *out++ = *s++;
-                        count++;
-                    }
-                    break;
-                }
-                case 'c': {
-                    char c = (char)va_arg(args, int);
-                    *out++ = c;
-                    count++;
-                    break;
-                }
-                default:
-                    *out++ = '%';
-                    *out++ = *p;
-                    count += 2;
-                    break;
-            }
-        } else {
-            *out++ = *p;
-            count++;
-        }
-        p++;
-    }
-    
-    *out = '\0';
+    int count = vsnprintf(str, SIZE_MAX, format, args);
     va_end(args);
     return count;
 }
@@ -291,49 +327,26 @@ int sprintf(char* str, const char* format, ...) {
 // ================================
 
 void LogWrite(const char* pSource, unsigned Severity, const char* pMessage, ...) {
-    // Implementação básica de logging
-    printf("[%s] ", pSource);
+    (void)Severity;
     
-    va_list args;
-    va_start(args, pMessage);
+    // Linha inteira montada no mesmo buffer: chega ao anel de uma vez
+    UartSinkBuffer buf;
+    buf.len = 0;
     
-    const char* p = pMessage;
-    while (*p) {
-        if (*p == '%' && *(p + 1)) {
-            p++;
-            switch (*p) {
-                case 'd': {
-                    int val = va_arg(args, int);
-                    printf("%d", val);
-                    break;
-                }
-                case 's': {
-                    char* str = va_arg(args, char*);
-                    printf("%s", str);
-                    break;
-                }
-                case 'x': {
-                    unsigned int val = va_arg(args, unsigned int);
-                    printf("%x", val);
-                    break;
-                }
-                default:
-                    putchar_basic('%');
-                    putchar_basic(*p);
-                    break;
-            }
-        } else {
-            putchar_basic(*p);
-        }
-        p++;
-    }
+    uart_sink_printf(&buf, "[%s] ", pSource);
     
+    va_list args;
+    va_start(args, pMessage);
+    vformat(uart_sink, &buf, pMessage, args);
     va_end(args);
-    putchar_basic('\n');
+    
+    uart_sink(&buf, "\n", 1);
+    uart_sink_flush(&buf);
 }
 
 void uspi_assertion_failed(const char* pExpr, const char* pFile, unsigned nLine) {
     printf("ASSERTION FAILED: %s at %s:%d\n", pExpr, pFile, nLine);
+    uart_flush();
     
     // Para em caso de assertion failure
     while (1) {
@@ -357,69 +370,6 @@ int GetMACAddress(unsigned char Buffer[6]) {
     return 1;  // Sucesso
 }
 
-// ================================
-// INTERRUPT HANDLING
-// ================================
-
-void ConnectInterrupt(unsigned nIRQ, void (*pHandler)(void)) {
-    // Implementação stub - você precisa implementar se usar interrupções
-    (void)nIRQ;
-    (void)pHandler;
-}
-
-void DisconnectInterrupt(unsigned nIRQ) {
-    (void)nIRQ;
-}
-
-// ================================
-// ARM AEABI FUNCTIONS (required for division)
-// ================================
-
-unsigned int __aeabi_uidiv(unsigned int numerator, unsigned int denominator) {
-    if (denominator == 0) return 0;
-    
-    unsigned int quotient = 0;
-    unsigned int remainder = numerator;
-    
-    while (remainder >= denominator) {
-        unsigned int temp = denominator;
-        unsigned int multiple = 1;
-        
-        while ((temp << 1) <= remainder) {
-            temp <<= 1;
-            multiple <<= 1;
-        }
-        
-        remainder -= temp;
-        quotient += multiple;
-    }
-    
-    return quotient;
-}
-
-unsigned int __aeabi_uidivmod(unsigned int numerator, unsigned int denominator) {
-    if (denominator == 0) return 0;
-    
-    unsigned int quotient = __aeabi_uidiv(numerator, denominator);
-    return numerator - (quotient * denominator);  // Return remainder
-}
-
-int __aeabi_idiv(int numerator, int denominator) {
-    if (denominator == 0) return 0;
-    
-    int sign = 1;
-    if (numerator < 0) {
-        numerator = -numerator;
-        sign = -sign;
-    }
-    if (denominator < 0) {
-        denominator = -denominator;
-        sign = -sign;
-    }
-    
-    return sign * (int)__aeabi_uidiv((unsigned int)numerator, (unsigned int)denominator);
-}
-
 // ================================
 // POWER MANAGEMENT
 // ================================
@@ -435,59 +385,37 @@ int SetPowerStateOn(unsigned nDeviceId) {
 // KERNEL TIMER FUNCTIONS
 // ================================
 
-typedef struct {
-    unsigned int active;
-    unsigned int timeout;
-    void (*handler)(unsigned int, void*);
-    void* param;
-    unsigned int hTimer;
-} KernelTimer;
+// Timers da USPi numa roda hierárquica com tick de 1/100 s (a granularidade
+// da API). O tick periódico do timer.c chama ProcessKernelTimers em IRQ.
+#define KERNEL_TIMER_TICK_US 10000
 
-#define MAX_TIMERS 16
-static KernelTimer timers[MAX_TIMERS];
-static unsigned int next_timer_id = 1;
+typedef void TKernelTimerHandler(unsigned hTimer, void *pParam, void *pContext);
+
+static TimerWheel kernel_timers;
 
 unsigned int StartKernelTimer(unsigned nHundredthsOfSecond, 
-                              void (*pHandler)(unsigned int hTimer, void *pParam),
+                              TKernelTimerHandler *pHandler,
                               void *pParam, void *pContext) {
-    (void)pContext;
-    
-    // Encontra um slot livre
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        if (!timers[i].active) {
-            timers[i].active = 1;
-            timers[i].timeout = get_system_timer() + (nHundredthsOfSecond * 10000); // Convert to microseconds
-            timers[i].handler = pHandler;
-            timers[i].param = pParam;
-            timers[i].hTimer = next_timer_id++;
-            return timers[i].hTimer;
-        }
-    }
-    
-    return 0;  // No free timers
+    // A roda também é percorrida pelo tick (IRQ)
+    uint32_t flags = irq_save();
+    unsigned int handle = timer_wheel_start(&kernel_timers, get_system_timer(),
+                                            (uint64_t)nHundredthsOfSecond * KERNEL_TIMER_TICK_US,
+                                            pHandler, pParam, pContext);
+    irq_restore(flags);
+    return handle;
 }
 
 void CancelKernelTimer(unsigned int hTimer) {
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        if (timers[i].active && timers[i].hTimer == hTimer) {
-            timers[i].active = 0;
-            break;
-        }
-    }
+    uint32_t flags = irq_save();
+    timer_wheel_cancel(&kernel_timers, hTimer);
+    irq_restore(flags);
 }
 
-// Função para processar timers (deve ser chamada periodicamente)
+// Processa os timers vencidos; chamada pelo tick periódico (timer.c)
 void ProcessKernelTimers(void) {
-    uint64_t current_time = get_system_timer();
-    
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        if (timers[i].active && current_time >= timers[i].timeout) {
-            timers[i].active = 0;  // Timer fires only once
-            if (timers[i].handler) {
-                timers[i].handler(timers[i].hTimer, timers[i].param);
-            }
-        }
-    }
+    uint32_t flags = irq_save();
+    timer_wheel_advance(&kernel_timers, get_system_timer());
+    irq_restore(flags);
 }
 
 // ================================
@@ -524,60 +452,21 @@ void DebugHexdump(const void *pBuffer, unsigned nBufLen, const char *pSource) {
     }
 }
 
-// ================================
-// ADDITIONAL HELPER FUNCTIONS
-// ================================
-
-void* memset(void* s, int c, size_t n) {
-    unsigned char* ptr = (unsigned char*)s;
-    while (n--) {
-        *ptr++ = (unsigned char)c;
-    }
-    return s;
-}
-
-void* memcpy(void* dest, const void* src, size_t n) {
-    unsigned char* d = (unsigned char*)dest;
-    const unsigned char* s = (const unsigned char*)src;
-    while (n--) {
-        *d++ = *s++;
-    }
-    return dest;
-}
-
-int memcmp(const void* s1, const void* s2, size_t n) {
-    const unsigned char* p1 = (const unsigned char*)s1;
-    const unsigned char* p2 = (const unsigned char*)s2;
-    
-    while (n--) {
-        if (*p1 != *p2) {
-            return *p1 - *p2;
-        }
-        p1++;
-        p2++;
-    }
-    return 0;
-}
-
 // ================================
 // SYSTEM INITIALIZATION
 // ================================
 
 void init_system(void) {
-    // Initialize timer array
-    for (int i = 0; i < MAX_TIMERS; i++) {
-        timers[i].active = 0;
+    // Initialize heap and small-object pools
+    heap_init(heap, HEAP_SIZE);
+    for (int i = 0; i < SMALL_POOLS; i++) {
+        pool_init(&small_pools[i], small_pool_memory[i],
+                  small_pool_config[i].block_size, small_pool_config[i].count);
     }
     
-    // Initialize UART for debug output
-    volatile uint32_t* uart_cr = (uint32_t*)0x3F201030;
-    volatile uint32_t* uart_ibrd = (uint32_t*)0x3F201024;
-    volatile uint32_t* uart_fbrd = (uint32_t*)0x3F201028;
-    volatile uint32_t* uart_lcrh = (uint32_t*)0x3F20102C;
+    // Initialize kernel timers
+    timer_wheel_init(&kernel_timers, KERNEL_TIMER_TICK_US);
     
-    *uart_cr = 0;      // Disable UART
-    *uart_ibrd = 26;   // 115200 baud
-    *uart_fbrd = 3;
-    *uart_lcrh = 0x70; // 8 bits, FIFO enable
-    *uart_cr = 0x301;  // Enable UART, TX, RX
+    // Initialize UART for debug output (buffered, polled until uart_enable_irq)
+    uart_init();
 }
\ No newline at end of file
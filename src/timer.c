@@ -0,0 +1,149 @@
+//
+// timer.c - System timer, tick periódico e idle em WFI (Raspberry Pi 3)
+//
+
+#include "timer.h"
+#include "interrupts.h"
+#include "profile.h"
+
+// Registradores do system timer
+#define TIMER_BASE          0x3F003000
+#define TIMER_CS            ((volatile uint32_t*)(TIMER_BASE + 0x00))
+#define TIMER_CLO           ((volatile uint32_t*)(TIMER_BASE + 0x04))
+#define TIMER_CHI           ((volatile uint32_t*)(TIMER_BASE + 0x08))
+#define TIMER_C1            ((volatile uint32_t*)(TIMER_BASE + 0x10))
+#define TIMER_C3            ((volatile uint32_t*)(TIMER_BASE + 0x18))
+
+#define TIMER_CS_M1         (1 << 1)
+#define TIMER_CS_M3         (1 << 3)
+
+#define TICK_INTERVAL_US    (1000000 / TIMER_TICK_HZ)
+
+// Abaixo disso programar o comparador custa mais que esperar o contador
+#define SLEEP_MIN_US        20
+
+// Processamento dos timers do kernel (syscalls.c), feito no tick
+extern void ProcessKernelTimers(void);
+
+static volatile bool timer_ready = false;
+static volatile TimerStats stats;
+
+// Prazo programado em C1 (contagem baixa de 32 bits)
+static volatile uint32_t wakeup_compare;
+
+uint64_t get_system_timer(void) {
+    uint32_t hi1 = *TIMER_CHI;
+    uint32_t lo = *TIMER_CLO;
+    uint32_t hi2 = *TIMER_CHI;
+    
+    if (hi1 != hi2) {
+        lo = *TIMER_CLO;
+    }
+    
+    return ((uint64_t)hi2 << 32) | lo;
+}
+
+// C1: despertar do idle; só mede a latência, o WFI já foi interrompido
+static void wakeup_handler(void *param) {
+    (void)param;
+    
+    uint32_t latency = *TIMER_CLO - wakeup_compare;
+    *TIMER_CS = TIMER_CS_M1;
+    
+    stats.wakeups++;
+    stats.latency_total_us += latency;
+    if (latency < stats.latency_min_us) {
+        stats.latency_min_us = latency;
+    }
+    if (latency > stats.latency_max_us) {
+        stats.latency_max_us = latency;
+    }
+}
+
+// C3: tick periódico em grade fixa (sem acumular deriva)
+static void tick_handler(void *param) {
+    (void)param;
+    
+    uint32_t next = *TIMER_C3 + TICK_INTERVAL_US;
+    
+    // Se o handler atrasou mais de um período, retomar a partir de agora
+    if ((int32_t)(next - *TIMER_CLO) <= 0) {
+        next = *TIMER_CLO + TICK_INTERVAL_US;
+    }
+    *TIMER_C3 = next;
+    *TIMER_CS = TIMER_CS_M3;
+    
+    stats.ticks++;
+    profile_begin(PROFILE_TIMERS);
+    ProcessKernelTimers();
+    profile_end(PROFILE_TIMERS);
+}
+
+void timer_reset_stats(void) {
+    uint32_t flags = irq_save();
+    stats.wakeups = 0;
+    stats.latency_min_us = UINT32_MAX;
+    stats.latency_max_us = 0;
+    stats.latency_total_us = 0;
+    stats.idle_us = 0;
+    irq_restore(flags);
+}
+
+void timer_get_stats(TimerStats *out) {
+    uint32_t flags = irq_save();
+    out->wakeups = stats.wakeups;
+    out->latency_min_us = stats.wakeups ? stats.latency_min_us : 0;
+    out->latency_max_us = stats.latency_max_us;
+    out->latency_total_us = stats.latency_total_us;
+    out->idle_us = stats.idle_us;
+    out->ticks = stats.ticks;
+    irq_restore(flags);
+}
+
+void timer_init(void) {
+    timer_reset_stats();
+    stats.ticks = 0;
+    
+    *TIMER_CS = TIMER_CS_M1 | TIMER_CS_M3;
+    *TIMER_C3 = *TIMER_CLO + TICK_INTERVAL_US;
+    
+    ConnectInterrupt(IRQ_TIMER1, wakeup_handler, 0);
+    ConnectInterrupt(IRQ_TIMER3, tick_handler, 0);
+    timer_ready = true;
+}
+
+void timer_sleep_until(uint64_t deadline) {
+    uint64_t now = get_system_timer();
+    
+    if (!timer_ready || deadline <= now + SLEEP_MIN_US) {
+        while (get_system_timer() < deadline) {
+            __asm__ volatile("yield");
+        }
+        return;
+    }
+    
+    // O comparador só vê os 32 bits baixos: prazos além de ~71 min são
+    // atingidos em etapas
+    while (now < deadline) {
+        uint64_t target = deadline - now > 0x7FFFFFFF ? now + 0x7FFFFFFF : deadline;
+        
+        // Com IRQ mascarada o WFI ainda acorda com a linha pendente, mas o
+        // handler só roda depois do irq_restore: sem janela entre o teste
+        // do contador e o WFI
+        uint32_t flags = irq_save();
+        wakeup_compare = (uint32_t)target;
+        *TIMER_CS = TIMER_CS_M1;
+        *TIMER_C1 = (uint32_t)target;
+        
+        if (get_system_timer() < target) {
+            __asm__ volatile("dsb sy\n\twfi" ::: "memory");
+        }
+        
+        // Contabilizado antes de liberar a IRQ: o handler e o relatório
+        // também mexem nas estatísticas, e o tempo dele não é ocioso
+        uint64_t woke = get_system_timer();
+        stats.idle_us += woke - now;
+        irq_restore(flags);
+        now = woke;
+    }
+}
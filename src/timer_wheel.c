@@ -0,0 +1,257 @@
+//
+// timer_wheel.c - Roda de timers hierárquica (timers do kernel da USPi)
+//
+
+#include <stdlib.h>
+#include "timer_wheel.h"
+
+#define SLOT_MASK       (TIMER_WHEEL_SLOTS - 1)
+#define INDEX_MASK      ((1u << TIMER_WHEEL_INDEX_BITS) - 1)
+
+// ================================
+// LISTAS
+// ================================
+
+static void list_init(TimerList *list) {
+    list->prev = list;
+    list->next = list;
+}
+
+static bool list_empty(const TimerList *list) {
+    return list->next == list;
+}
+
+static void list_append(TimerList *list, TimerList *item) {
+    item->prev = list->prev;
+    item->next = list;
+    list->prev->next = item;
+    list->prev = item;
+}
+
+static void list_remove(TimerList *item) {
+    item->prev->next = item->next;
+    item->next->prev = item->prev;
+    item->prev = item;
+    item->next = item;
+}
+
+// Move todos os itens de 'from' para 'to' (vazia) e esvazia 'from'
+static void list_take(TimerList *to, TimerList *from) {
+    if (list_empty(from)) {
+        list_init(to);
+        return;
+    }
+    to->next = from->next;
+    to->prev = from->prev;
+    to->next->prev = to;
+    to->prev->next = to;
+    list_init(from);
+}
+
+// ================================
+// ALOCAÇÃO DE TIMERS
+// ================================
+
+static TimerNode *node_at(TimerWheel *wheel, uint32_t index) {
+    return &wheel->chunks[index / TIMER_WHEEL_CHUNK][index % TIMER_WHEEL_CHUNK];
+}
+
+static TimerNode *node_alloc(TimerWheel *wheel) {
+    if (wheel->free_list) {
+        TimerNode *node = wheel->free_list;
+        wheel->free_list = (TimerNode *)node->link.next;
+        return node;
+    }
+    
+    if (wheel->allocated >= TIMER_WHEEL_MAX_TIMERS) {
+        return NULL;
+    }
+    
+    // Novo bloco quando o atual está cheio
+    uint32_t index = wheel->allocated;
+    if (index % TIMER_WHEEL_CHUNK == 0) {
+        TimerNode *chunk = malloc(sizeof(TimerNode) * TIMER_WHEEL_CHUNK);
+        if (!chunk) {
+            return NULL;
+        }
+        wheel->chunks[index / TIMER_WHEEL_CHUNK] = chunk;
+    }
+    
+    TimerNode *node = node_at(wheel, index);
+    node->handle = index + 1;
+    node->active = false;
+    wheel->allocated++;
+    return node;
+}
+
+// Devolve o timer à lista livre com a geração avançada: o handle antigo
+// deixa de corresponder
+static void node_free(TimerWheel *wheel, TimerNode *node) {
+    uint32_t generation = (node->handle >> TIMER_WHEEL_INDEX_BITS) + 1;
+    node->handle = (generation << TIMER_WHEEL_INDEX_BITS) | (node->handle & INDEX_MASK);
+    node->active = false;
+    node->link.next = (TimerList *)wheel->free_list;
+    wheel->free_list = node;
+}
+
+// ================================
+// RODA
+// ================================
+
+// Posiciona o timer pelo quanto falta: quanto mais longe, mais alto o nível
+static void place(TimerWheel *wheel, TimerNode *node) {
+    uint64_t delta = node->deadline > wheel->now ? node->deadline - wheel->now : 0;
+    
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        int shift = TIMER_WHEEL_SLOT_BITS * level;
+        if (delta < ((uint64_t)TIMER_WHEEL_SLOTS << shift)) {
+            unsigned slot = (unsigned)(node->deadline >> shift) & SLOT_MASK;
+            list_append(&wheel->slots[level][slot], &node->link);
+            return;
+        }
+    }
+    list_append(&wheel->overflow, &node->link);
+}
+
+// Redistribui uma lista inteira a partir do tick atual
+static void redistribute(TimerWheel *wheel, TimerList *list) {
+    TimerList pending;
+    list_take(&pending, list);
+    
+    while (!list_empty(&pending)) {
+        TimerList *item = pending.next;
+        list_remove(item);
+        place(wheel, (TimerNode *)item);
+    }
+}
+
+// Ao completar uma volta de um nível, a posição corrente do nível de cima
+// desce; os níveis mais altos descem primeiro para caírem já no lugar certo
+static void cascade(TimerWheel *wheel) {
+    uint64_t t = wheel->now;
+    int top = 0;
+    
+    while (top < TIMER_WHEEL_LEVELS &&
+           ((t >> (TIMER_WHEEL_SLOT_BITS * top)) & SLOT_MASK) == 0) {
+        top++;
+    }
+    
+    if (top == TIMER_WHEEL_LEVELS) {
+        redistribute(wheel, &wheel->overflow);
+        top = TIMER_WHEEL_LEVELS - 1;
+    }
+    for (int level = top; level >= 1; level--) {
+        unsigned slot = (unsigned)(t >> (TIMER_WHEEL_SLOT_BITS * level)) & SLOT_MASK;
+        redistribute(wheel, &wheel->slots[level][slot]);
+    }
+}
+
+void timer_wheel_init(TimerWheel *wheel, uint64_t tick_us) {
+    wheel->tick_us = tick_us;
+    wheel->now = 0;
+    wheel->started = false;
+    wheel->active = 0;
+    
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++) {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++) {
+            list_init(&wheel->slots[level][slot]);
+        }
+    }
+    list_init(&wheel->overflow);
+    
+    wheel->free_list = NULL;
+    wheel->allocated = 0;
+}
+
+// A roda começa no instante do primeiro uso, não no tick zero
+static void wheel_start(TimerWheel *wheel, uint64_t now_us) {
+    if (!wheel->started) {
+        wheel->now = now_us / wheel->tick_us;
+        wheel->started = true;
+    }
+}
+
+unsigned timer_wheel_start(TimerWheel *wheel, uint64_t now_us, uint64_t delay_us,
+                           TimerWheelHandler *handler, void *param, void *context) {
+    wheel_start(wheel, now_us);
+    
+    TimerNode *node = node_alloc(wheel);
+    if (!node) {
+        return 0;
+    }
+    
+    // Arredondar para cima: nunca expirar antes do pedido. Prazos já
+    // vencidos (ou no tick corrente) expiram no próximo tick.
+    uint64_t deadline = (now_us + delay_us + wheel->tick_us - 1) / wheel->tick_us;
+    if (deadline <= wheel->now) {
+        deadline = wheel->now + 1;
+    }
+    
+    node->deadline = deadline;
+    node->handler = handler;
+    node->param = param;
+    node->context = context;
+    node->active = true;
+    place(wheel, node);
+    wheel->active++;
+    return node->handle;
+}
+
+bool timer_wheel_cancel(TimerWheel *wheel, unsigned handle) {
+    uint32_t index = handle & INDEX_MASK;
+    if (index == 0 || index > wheel->allocated) {
+        return false;
+    }
+    
+    TimerNode *node = node_at(wheel, index - 1);
+    if (!node->active || node->handle != handle) {
+        return false;
+    }
+    
+    list_remove(&node->link);
+    node_free(wheel, node);
+    wheel->active--;
+    return true;
+}
+
+unsigned timer_wheel_advance(TimerWheel *wheel, uint64_t now_us) {
+    wheel_start(wheel, now_us);
+    
+    uint64_t target = now_us / wheel->tick_us;
+    unsigned expired = 0;
+    
+    while (wheel->now < target) {
+        // Sem timers pendentes não há o que percorrer
+        if (wheel->active == 0) {
+            wheel->now = target;
+            break;
+        }
+        
+        wheel->now++;
+        cascade(wheel);
+        
+        // Separar a posição antes de rodar os handlers: timers agendados
+        // por eles caem em ticks futuros
+        TimerList due;
+        list_take(&due, &wheel->slots[0][wheel->now & SLOT_MASK]);
+        
+        while (!list_empty(&due)) {
+            TimerNode *node = (TimerNode *)due.next;
+            list_remove(&node->link);
+            
+            TimerWheelHandler *handler = node->handler;
+            void *param = node->param;
+            void *context = node->context;
+            unsigned handle = node->handle;
+            
+            node_free(wheel, node);
+            wheel->active--;
+            expired++;
+            
+            if (handler) {
+                handler(handle, param, context);
+            }
+        }
+    }
+    return expired;
+}
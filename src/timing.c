@@ -0,0 +1,48 @@
+//
+// timing.c - Passo fixo de simulação e cadência de frames
+//
+
+#include "timing.h"
+
+void frame_clock_init(FrameClock *clock, uint64_t now, uint64_t step_us, uint64_t frame_us) {
+    clock->step_us = step_us;
+    clock->frame_us = frame_us;
+    clock->last_time = now;
+    clock->accumulator = 0;
+    clock->next_frame = now;
+    clock->max_steps = MAX_CATCHUP_STEPS;
+    clock->dropped_steps = 0;
+}
+
+uint32_t frame_clock_steps(FrameClock *clock, uint64_t now) {
+    clock->accumulator += now - clock->last_time;
+    clock->last_time = now;
+    
+    uint64_t steps = clock->accumulator / clock->step_us;
+    clock->accumulator -= steps * clock->step_us;
+    
+    // Depois de um travamento longo, não tentar recuperar tudo de uma vez
+    if (steps > clock->max_steps) {
+        clock->dropped_steps += (uint32_t)(steps - clock->max_steps);
+        steps = clock->max_steps;
+    }
+    return (uint32_t)steps;
+}
+
+bool frame_clock_render_due(FrameClock *clock, uint64_t now) {
+    if (now < clock->next_frame) {
+        return false;
+    }
+    
+    // Manter a grade de frames; se perdemos vários, recomeçar a partir de agora
+    clock->next_frame += clock->frame_us;
+    if (clock->next_frame <= now) {
+        clock->next_frame = now + clock->frame_us;
+    }
+    return true;
+}
+
+uint64_t frame_clock_next_deadline(const FrameClock *clock) {
+    uint64_t next_step = clock->last_time + (clock->step_us - clock->accumulator);
+    return next_step < clock->next_frame ? next_step : clock->next_frame;
+}
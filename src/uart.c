@@ -0,0 +1,191 @@
+//
+// uart.c - Console PL011 com anel de transmissão esvaziado por IRQ
+//
+
+#include <string.h>
+
+#include "uart.h"
+#include "interrupts.h"
+
+// Registradores do PL011 (UART0)
+#define UART_BASE           0x3F201000
+#define UART_DR             ((volatile uint32_t*)(UART_BASE + 0x00))
+#define UART_FR             ((volatile uint32_t*)(UART_BASE + 0x18))
+#define UART_IBRD           ((volatile uint32_t*)(UART_BASE + 0x24))
+#define UART_FBRD           ((volatile uint32_t*)(UART_BASE + 0x28))
+#define UART_LCRH           ((volatile uint32_t*)(UART_BASE + 0x2C))
+#define UART_CR             ((volatile uint32_t*)(UART_BASE + 0x30))
+#define UART_IFLS           ((volatile uint32_t*)(UART_BASE + 0x34))
+#define UART_IMSC           ((volatile uint32_t*)(UART_BASE + 0x38))
+#define UART_MIS            ((volatile uint32_t*)(UART_BASE + 0x40))
+#define UART_ICR            ((volatile uint32_t*)(UART_BASE + 0x44))
+
+#define UART_FR_BUSY        (1 << 3)
+#define UART_FR_TXFF        (1 << 5)
+#define UART_FR_TXFE        (1 << 7)
+#define UART_INT_TX         (1 << 5)
+
+#define TX_MASK             (UART_TX_BUFFER_SIZE - 1)
+
+// Anel de transmissão: tx_head só é escrito pelo produtor (escritas com IRQ
+// mascarada, o que também serializa printf chamado dentro de handlers) e
+// tx_tail só pelo consumidor (IRQ de TX ou uart_poll). Índices livres,
+// reduzidos com TX_MASK no acesso.
+static char tx_buffer[UART_TX_BUFFER_SIZE];
+static volatile uint32_t tx_head = 0;
+static volatile uint32_t tx_tail = 0;
+
+// IRQ de TX armada: a FIFO tem dados e a interrupção chegará ao esvaziar
+static volatile bool tx_irq_armed = false;
+static bool irq_connected = false;
+static UartOverflowPolicy overflow_policy = UART_OVERFLOW_DROP;
+static volatile UartStats stats;
+
+// Move bytes do anel para a FIFO enquanto houver espaço (IRQ mascarada)
+static void fill_fifo(void) {
+    uint32_t tail = tx_tail;
+    uint32_t head = tx_head;
+    
+    while (tail != head && !(*UART_FR & UART_FR_TXFF)) {
+        *UART_DR = (uint8_t)tx_buffer[tail & TX_MASK];
+        tail++;
+    }
+    tx_tail = tail;
+}
+
+// Com o anel vazio a IRQ é desarmada; senão a FIFO está cheia (acima do
+// nível de disparo) e a interrupção virá quando ela descer até ele
+static void update_tx_irq(void) {
+    if (!irq_connected) {
+        return;
+    }
+    
+    bool pending = tx_tail != tx_head;
+    if (pending && !tx_irq_armed) {
+        *UART_IMSC |= UART_INT_TX;
+    } else if (!pending && tx_irq_armed) {
+        *UART_IMSC &= ~UART_INT_TX;
+    }
+    tx_irq_armed = pending;
+}
+
+static void uart_irq_handler(void *param) {
+    (void)param;
+    
+    *UART_ICR = UART_INT_TX;
+    fill_fifo();
+    update_tx_irq();
+}
+
+void uart_init(void) {
+    *UART_CR = 0;           // Desabilita a UART
+    *UART_ICR = 0x7FF;      // Limpa interrupções pendentes
+    *UART_IMSC = 0;
+    *UART_IBRD = 26;        // 115200 baud
+    *UART_FBRD = 3;
+    *UART_LCRH = 0x70;      // 8 bits, FIFO habilitada
+    *UART_IFLS = 0;         // IRQ de TX com a FIFO em 1/8
+    *UART_CR = 0x301;       // Habilita UART, TX, RX
+    
+    tx_head = 0;
+    tx_tail = 0;
+    tx_irq_armed = false;
+    irq_connected = false;
+}
+
+void uart_enable_irq(void) {
+    uint32_t flags = irq_save();
+    ConnectInterrupt(IRQ_UART, uart_irq_handler, 0);
+    irq_connected = true;
+    fill_fifo();
+    update_tx_irq();
+    irq_restore(flags);
+}
+
+void uart_set_overflow_policy(UartOverflowPolicy policy) {
+    overflow_policy = policy;
+}
+
+size_t uart_write(const char *data, size_t len) {
+    size_t written = 0;
+    
+    while (len > 0) {
+        uint32_t flags = irq_save();
+        uint32_t head = tx_head;
+        uint32_t space = UART_TX_BUFFER_SIZE - (head - tx_tail);
+        uint32_t chunk = len < space ? (uint32_t)len : space;
+        
+        // Até duas cópias: do head ao fim do buffer e do início em diante
+        uint32_t offset = head & TX_MASK;
+        uint32_t first = UART_TX_BUFFER_SIZE - offset;
+        if (first > chunk) {
+            first = chunk;
+        }
+        memcpy(&tx_buffer[offset], data, first);
+        memcpy(tx_buffer, data + first, chunk - first);
+        
+        __asm__ volatile("dmb sy" ::: "memory");
+        tx_head = head + chunk;
+        
+        uint32_t used = tx_head - tx_tail;
+        if (used > stats.peak_used) {
+            stats.peak_used = used;
+        }
+        stats.bytes_written += chunk;
+        
+        // Escorvar a FIFO: a IRQ de TX só dispara ao descer até o nível
+        if (!tx_irq_armed) {
+            fill_fifo();
+        }
+        update_tx_irq();
+        irq_restore(flags);
+        
+        data += chunk;
+        len -= chunk;
+        written += chunk;
+        
+        if (len > 0) {
+            if (overflow_policy == UART_OVERFLOW_DROP) {
+                flags = irq_save();
+                stats.bytes_dropped += len;
+                irq_restore(flags);
+                break;
+            }
+            // Bloqueio: alimenta a FIFO diretamente, o que funciona também
+            // com IRQ mascarada (printf dentro de um handler)
+            while (tx_head - tx_tail == UART_TX_BUFFER_SIZE) {
+                uart_poll();
+            }
+        }
+    }
+    
+    return written;
+}
+
+void uart_putc(char c) {
+    uart_write(&c, 1);
+}
+
+void uart_poll(void) {
+    uint32_t flags = irq_save();
+    fill_fifo();
+    update_tx_irq();
+    irq_restore(flags);
+}
+
+void uart_flush(void) {
+    while (tx_head != tx_tail) {
+        uart_poll();
+    }
+    while ((*UART_FR & UART_FR_BUSY) || !(*UART_FR & UART_FR_TXFE)) {
+        __asm__ volatile("nop");
+    }
+}
+
+void uart_get_stats(UartStats *out) {
+    uint32_t flags = irq_save();
+    out->bytes_written = stats.bytes_written;
+    out->bytes_dropped = stats.bytes_dropped;
+    out->peak_used = stats.peak_used;
+    irq_restore(flags);
+}